@@ -0,0 +1,653 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "arena.h"
+#include "board.h"
+#include "rng.h"
+#include "sim.h"
+
+// === CONSTANTS ===
+#define ARENA_CONTESTED 0xFFFFFFFFu  // Claim of a tile wanted by two heads or more
+#define MAX_ARENA_THREADS 256        // Upper limit for --threads
+
+// Movement of one tile for each direction
+static const Cell arenaDelta[4] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+
+// === ACCESS A SEGMENT ===
+Cell ArenaSegment(const ArenaSnake* snake, int index)
+{
+    return snake->cells[(snake->headIndex + index) % snake->capacity];
+}
+
+// === READ A TILE ===
+CellType GetArenaCell(const Arena* arena, Cell cell)
+{
+    if (cell.x < 0 || cell.x >= arena->columns || cell.y < 0 || cell.y >= arena->rows) return CELL_EMPTY;
+    const ArenaBand* band = &arena->bands[cell.y / ARENA_BAND_ROWS];
+    return (CellType)band->board.cells[(cell.y - band->firstRow) * arena->columns + cell.x];
+}
+
+// === WRITE A TILE ===
+// Only the thread owning the band may call it during a tick
+static void SetArenaCell(Arena* arena, Cell cell, CellType type)
+{
+    ArenaBand* band = &arena->bands[cell.y / ARENA_BAND_ROWS];
+    SetBoardCell(&band->board, (Cell){ cell.x, cell.y - band->firstRow }, type);
+}
+
+// === PICK A RANDOM EMPTY TILE ===
+// The band is chosen in proportion to its free tiles, then the tile inside it
+static bool RandomArenaCell(Arena* arena, Cell* cell)
+{
+    int freeCount = 0;
+    for (int b = 0; b < arena->bandCount; b++) freeCount += arena->bands[b].board.freeCount;
+    if (freeCount == 0) return false;
+
+    int slot = RngRange(&arena->random, freeCount);
+    for (int b = 0; b < arena->bandCount; b++)
+    {
+        const ArenaBand* band = &arena->bands[b];
+        if (slot < band->board.freeCount)
+        {
+            *cell = BoardCell(&band->board, band->board.freeCells[slot]);
+            cell->y += band->firstRow;
+            return true;
+        }
+        slot -= band->board.freeCount;
+    }
+    return false;
+}
+
+// === QUEUE A TILE CHANGE ===
+// From the band of the snake's head to the band of the tile
+static void QueueChange(Arena* arena, ArenaBand* from, Cell cell, CellType type)
+{
+    ArenaChanges* changes = &from->changes[cell.y / ARENA_BAND_ROWS];
+    if (changes->count == changes->capacity)
+    {
+        int capacity = changes->capacity ? changes->capacity * 2 : 64;
+        int* items = realloc(changes->items, sizeof(int) * (size_t)capacity);
+        if (!items)
+        {
+            from->failed = true; // The change is lost: the board and the snake disagree
+            return;
+        }
+        changes->items = items;
+        changes->capacity = capacity;
+    }
+    changes->items[changes->count++] = ((cell.y * arena->columns + cell.x) << 2) | (int)type;
+}
+
+// === DOUBLE THE BUFFER OF A SNAKE ===
+// Segments are copied in order: the head moves to index 0
+static bool GrowArenaSnake(ArenaSnake* snake)
+{
+    int capacity = snake->capacity * 2;
+    Cell* cells = malloc(sizeof(Cell) * (size_t)capacity);
+    if (!cells) return false;
+    for (int i = 0; i < snake->length; i++)
+        cells[i] = ArenaSegment(snake, i);
+    free(snake->cells);
+    snake->cells = cells;
+    snake->capacity = capacity;
+    snake->headIndex = 0;
+    return true;
+}
+
+// === PUT A SNAKE ON THE BOARD ===
+// One segment on a random empty tile; the rest of the body grows on the next moves
+static bool SpawnArenaSnake(Arena* arena, ArenaSnake* snake)
+{
+    Cell cell;
+    if (!RandomArenaCell(arena, &cell)) return false;
+
+    snake->headIndex = 0;
+    snake->length = 1;
+    snake->growth = START_LENGTH - 1;
+    snake->cells[0] = cell;
+    snake->direction = (Direction)RngRange(&arena->random, 4);
+    snake->alive = true;
+    SetArenaCell(arena, cell, CELL_BODY);
+    return true;
+}
+
+// === KEEP THE FRUITS ON THE BOARD ===
+static void SpawnArenaFruits(Arena* arena)
+{
+    Cell cell;
+    while (arena->fruitCount < arena->fruitTarget && RandomArenaCell(arena, &cell))
+    {
+        SetArenaCell(arena, cell, CELL_FRUIT);
+        arena->fruitCount++;
+    }
+}
+
+// === PHASE 1A: DECIDE AND CLAIM ===
+// Any fruit next to the head is taken; otherwise the snake mostly keeps going
+// while it can and turns at random to a free tile. The board is only read.
+static void DecideArenaSnake(Arena* arena, int id)
+{
+    ArenaSnake* snake = &arena->snakes[id];
+    Cell head = ArenaSegment(snake, 0);
+    Direction reverse = (Direction)((snake->direction + 2) % 4);
+
+    Direction freeTurns[3];
+    int freeCount = 0;
+    Direction choice = DIRECTION_NONE;
+    bool straightFree = false;
+    for (int turn = DIRECTION_UP; turn <= DIRECTION_LEFT && choice == DIRECTION_NONE; turn++)
+    {
+        if (turn == reverse) continue;
+        Cell next = { head.x + arenaDelta[turn].x, head.y + arenaDelta[turn].y };
+        if (next.x < 0 || next.x >= arena->columns || next.y < 0 || next.y >= arena->rows) continue;
+
+        CellType type = GetArenaCell(arena, next);
+        if (type == CELL_FRUIT) choice = (Direction)turn;
+        else if (type == CELL_EMPTY)
+        {
+            freeTurns[freeCount++] = (Direction)turn;
+            if (turn == (int)snake->direction) straightFree = true;
+        }
+    }
+
+    uint32_t value = NextRng(&snake->random);
+    if (choice == DIRECTION_NONE)
+    {
+        if (straightFree && value % 8 != 0) choice = snake->direction;
+        else if (freeCount > 0) choice = freeTurns[(value >> 3) % (uint32_t)freeCount];
+        else choice = snake->direction;     // Trapped: runs into whatever is ahead
+    }
+    snake->direction = choice;
+    snake->target = (Cell){ head.x + arenaDelta[choice].x, head.y + arenaDelta[choice].y };
+    if (snake->target.x < 0 || snake->target.x >= arena->columns ||
+        snake->target.y < 0 || snake->target.y >= arena->rows)
+        return;                             // Off the board: nothing to claim
+
+    // The first claimer stamps the tile; any later one marks it contested.
+    // The final value does not depend on the order the claims came in.
+    _Atomic uint64_t* claim = &arena->claims[snake->target.y * arena->columns + snake->target.x];
+    uint64_t stamp = (uint64_t)(uint32_t)arena->tick << 32;
+    uint64_t mine = stamp | (uint32_t)(id + 1);
+    uint64_t contested = stamp | ARENA_CONTESTED;
+    uint64_t seen = atomic_load_explicit(claim, memory_order_relaxed);
+    for (;;)
+    {
+        uint64_t wanted = ((seen >> 32) != (uint32_t)arena->tick) ? mine : contested;
+        if (seen == contested ||
+            atomic_compare_exchange_weak_explicit(claim, &seen, wanted, memory_order_relaxed, memory_order_relaxed))
+            return;
+    }
+}
+
+// === PHASE 1B: RESOLVE AND MOVE ===
+// Only this snake and the band of its head are written; the board is read as
+// it was before the tick
+static void MoveArenaSnake(Arena* arena, ArenaBand* band, int id)
+{
+    ArenaSnake* snake = &arena->snakes[id];
+    Cell target = snake->target;
+    bool onBoard = target.x >= 0 && target.x < arena->columns && target.y >= 0 && target.y < arena->rows;
+    CellType type = onBoard ? GetArenaCell(arena, target) : CELL_BODY;
+
+    bool headOn = false;
+    if (onBoard && type != CELL_BODY)
+    {
+        uint64_t claim = atomic_load_explicit(&arena->claims[target.y * arena->columns + target.x], memory_order_relaxed);
+        headOn = (uint32_t)claim != (uint32_t)(id + 1);
+    }
+
+    if (type == CELL_BODY || headOn)
+    {
+        // The whole body leaves the board
+        for (int i = 0; i < snake->length; i++)
+            QueueChange(arena, band, ArenaSegment(snake, i), CELL_EMPTY);
+        snake->alive = false;
+        snake->respawnTick = arena->tick + ARENA_RESPAWN_TICKS;
+        if (headOn) band->headOnDeaths++;
+        else band->bodyDeaths++;
+        return;
+    }
+
+    // Grow by keeping the tail, otherwise the tail leaves its tile
+    if (snake->growth > 0 && (snake->length < snake->capacity || GrowArenaSnake(snake)))
+    {
+        snake->growth--;
+        snake->length++;
+    }
+    else
+    {
+        QueueChange(arena, band, ArenaSegment(snake, snake->length - 1), CELL_EMPTY);
+    }
+
+    snake->headIndex = (snake->headIndex == 0) ? snake->capacity - 1 : snake->headIndex - 1;
+    snake->cells[snake->headIndex] = target;
+    QueueChange(arena, band, target, CELL_BODY);
+    if (type == CELL_FRUIT)
+    {
+        snake->growth++;
+        band->eaten++;
+    }
+}
+
+// === PHASE 2: APPLY THE CHANGES OF ONE BAND ===
+// Lists are read in band order, each in the order its snakes queued them
+static void ApplyArenaChanges(Arena* arena, int bandIndex)
+{
+    for (int from = 0; from < arena->bandCount; from++)
+    {
+        ArenaChanges* changes = &arena->bands[from].changes[bandIndex];
+        for (int i = 0; i < changes->count; i++)
+        {
+            int index = changes->items[i] >> 2;
+            SetArenaCell(arena, (Cell){ index % arena->columns, index / arena->columns }, (CellType)(changes->items[i] & 3));
+        }
+        changes->count = 0;
+    }
+}
+
+// === WAIT FOR THE CLAIMS OF A BAND ===
+// Its snakes belong to another thread; the claims they made are visible after it
+static void WaitArenaClaims(const Arena* arena, int bandIndex)
+{
+    while (atomic_load_explicit(&arena->bands[bandIndex].claimedTick, memory_order_acquire) != arena->tick)
+        thrd_yield();
+}
+
+// === RUN A PHASE ON A SHARE OF THE BANDS ===
+static void RunArenaShare(Arena* arena, const ArenaWorker* worker)
+{
+    if (arena->phase == ARENA_APPLY)
+    {
+        for (int b = worker->firstBand; b < worker->endBand; b++)
+            ApplyArenaChanges(arena, b);
+        return;
+    }
+
+    for (int b = worker->firstBand; b < worker->endBand; b++)
+    {
+        for (int i = arena->bandStart[b]; i < arena->bandStart[b + 1]; i++)
+            DecideArenaSnake(arena, arena->order[i]);
+        atomic_store_explicit(&arena->bands[b].claimedTick, arena->tick, memory_order_release);
+    }
+
+    // The tiles the heads of the share go to are only claimed from the share
+    // and the band on each side of it
+    if (worker->firstBand == worker->endBand) return;
+    if (worker->firstBand > 0) WaitArenaClaims(arena, worker->firstBand - 1);
+    if (worker->endBand < arena->bandCount) WaitArenaClaims(arena, worker->endBand);
+    for (int b = worker->firstBand; b < worker->endBand; b++)
+    {
+        for (int i = arena->bandStart[b]; i < arena->bandStart[b + 1]; i++)
+            MoveArenaSnake(arena, &arena->bands[b], arena->order[i]);
+    }
+}
+
+// === WORKER THREAD ===
+// Sleeps until a phase starts, runs its share, reports, and sleeps again
+static int ArenaWorkerMain(void* argument)
+{
+    ArenaWorker* worker = argument;
+    Arena* arena = worker->arena;
+    unsigned int seen = 0;
+
+    for (;;)
+    {
+        mtx_lock(&arena->lock);
+        while (arena->generation == seen && !arena->quit)
+            cnd_wait(&arena->start, &arena->lock);
+        bool quit = arena->quit;
+        seen = arena->generation;
+        mtx_unlock(&arena->lock);
+        if (quit) return 0;
+
+        RunArenaShare(arena, worker);
+
+        mtx_lock(&arena->lock);
+        if (--arena->pending == 0) cnd_signal(&arena->finished);
+        mtx_unlock(&arena->lock);
+    }
+}
+
+// === RUN A PHASE ON EVERY BAND ===
+// The barrier at the end makes the writes of the phase visible to the next one
+static void RunArenaPhase(Arena* arena, ArenaPhase phase)
+{
+    arena->phase = phase;
+    if (arena->threadCount == 1)
+    {
+        RunArenaShare(arena, &arena->workers[0]);
+        return;
+    }
+
+    mtx_lock(&arena->lock);
+    arena->generation++;
+    arena->pending = arena->threadCount - 1;
+    cnd_broadcast(&arena->start);
+    mtx_unlock(&arena->lock);
+
+    RunArenaShare(arena, &arena->workers[0]);
+
+    mtx_lock(&arena->lock);
+    while (arena->pending > 0)
+        cnd_wait(&arena->finished, &arena->lock);
+    mtx_unlock(&arena->lock);
+}
+
+// === GROUP THE LIVING SNAKES BY BAND ===
+// Counting sort: snakes of a band stay in id order
+static void SortArenaSnakes(Arena* arena)
+{
+    memset(arena->bandStart, 0, sizeof(int) * (size_t)(arena->bandCount + 1));
+    for (int i = 0; i < arena->snakeCount; i++)
+    {
+        if (arena->snakes[i].alive)
+            arena->bandStart[ArenaSegment(&arena->snakes[i], 0).y / ARENA_BAND_ROWS + 1]++;
+    }
+    for (int b = 0; b < arena->bandCount; b++)
+        arena->bandStart[b + 1] += arena->bandStart[b];
+
+    // Filled from the back: each band end moves down to the band start
+    int total = arena->bandStart[arena->bandCount];
+    for (int i = arena->snakeCount - 1; i >= 0; i--)
+    {
+        if (!arena->snakes[i].alive) continue;
+        int band = ArenaSegment(&arena->snakes[i], 0).y / ARENA_BAND_ROWS;
+        arena->order[--arena->bandStart[band + 1]] = i;
+    }
+    memmove(arena->bandStart, arena->bandStart + 1, sizeof(int) * (size_t)arena->bandCount);
+    arena->bandStart[arena->bandCount] = total;
+}
+
+// === ADVANCE EVERY SNAKE BY ONE TICK ===
+void StepArena(Arena* arena)
+{
+    arena->tick++;      // Claims of the previous tick carry an older stamp
+    SortArenaSnakes(arena);
+    int moving = arena->bandStart[arena->bandCount];
+
+    RunArenaPhase(arena, ARENA_MOVE);
+    RunArenaPhase(arena, ARENA_APPLY);
+
+    // Totals of the bands
+    for (int b = 0; b < arena->bandCount; b++)
+    {
+        ArenaBand* band = &arena->bands[b];
+        arena->fruitCount -= band->eaten;
+        arena->stats.fruitsEaten += band->eaten;
+        arena->stats.headOnDeaths += band->headOnDeaths;
+        arena->stats.bodyDeaths += band->bodyDeaths;
+        moving -= band->headOnDeaths + band->bodyDeaths;
+        band->eaten = band->headOnDeaths = band->bodyDeaths = 0;
+    }
+    arena->stats.moves += moving;
+
+    // Dead snakes come back in id order, then the eaten fruits are replaced
+    for (int i = 0; i < arena->snakeCount; i++)
+    {
+        ArenaSnake* snake = &arena->snakes[i];
+        if (!snake->alive && arena->tick >= snake->respawnTick && SpawnArenaSnake(arena, snake))
+            arena->stats.respawns++;
+    }
+    SpawnArenaFruits(arena);
+}
+
+// === INITIALIZE THE ARENA ===
+bool InitArena(Arena* arena, const ArenaConfig* config)
+{
+    *arena = (Arena){ 0 };
+    if (config->snakes < 1 || config->snakes > ARENA_MAX_SNAKES || config->columns < 1 || config->rows < 1 ||
+        (long long)config->columns * config->rows > (INT32_MAX >> 2) || config->snakes > config->columns * config->rows)
+        return false;
+    if (mtx_init(&arena->lock, mtx_plain) != thrd_success) return false;
+    if (cnd_init(&arena->start) != thrd_success)
+    {
+        mtx_destroy(&arena->lock);
+        return false;
+    }
+    if (cnd_init(&arena->finished) != thrd_success)
+    {
+        cnd_destroy(&arena->start);
+        mtx_destroy(&arena->lock);
+        return false;
+    }
+
+    arena->columns = config->columns;
+    arena->rows = config->rows;
+    arena->fruitTarget = config->fruits;
+    SeedRng(&arena->random, config->seed, RNG_STREAM_GAMEPLAY);
+
+    // --- Board bands and the lists between them ---
+    int bandCount = (config->rows + ARENA_BAND_ROWS - 1) / ARENA_BAND_ROWS;
+    size_t cellCount = (size_t)config->columns * (size_t)config->rows;
+    arena->bands = calloc((size_t)bandCount, sizeof(ArenaBand));
+    arena->claims = calloc(cellCount, sizeof(_Atomic uint64_t));
+    arena->bandStart = malloc(sizeof(int) * (size_t)(bandCount + 1));
+    arena->order = malloc(sizeof(int) * (size_t)config->snakes);
+    arena->snakes = calloc((size_t)config->snakes, sizeof(ArenaSnake));
+    if (!arena->bands || !arena->claims || !arena->bandStart || !arena->order || !arena->snakes)
+    {
+        FreeArena(arena);
+        return false;
+    }
+
+    // bandCount only covers the bands created, so a failure frees exactly those
+    for (int b = 0; b < bandCount; b++)
+    {
+        ArenaBand* band = &arena->bands[b];
+        int rows = config->rows - b * ARENA_BAND_ROWS;
+        band->firstRow = b * ARENA_BAND_ROWS;
+        band->changes = calloc((size_t)bandCount, sizeof(ArenaChanges));
+        if (!band->changes || !InitBoard(&band->board, config->columns, rows < ARENA_BAND_ROWS ? rows : ARENA_BAND_ROWS))
+        {
+            free(band->changes);
+            FreeArena(arena);
+            return false;
+        }
+        arena->bandCount++;
+    }
+
+    // --- Snakes, then fruits, in the free tiles ---
+    for (int i = 0; i < config->snakes; i++)
+    {
+        ArenaSnake* snake = &arena->snakes[i];
+        snake->cells = malloc(sizeof(Cell) * ARENA_START_CAPACITY);
+        arena->snakeCount++;
+        if (!snake->cells)
+        {
+            FreeArena(arena);
+            return false;
+        }
+        snake->capacity = ARENA_START_CAPACITY;
+        SeedRng(&snake->random, (uint64_t)config->seed + (uint64_t)i, RNG_STREAM_CONTROLLER);
+        SpawnArenaSnake(arena, snake);
+    }
+    SpawnArenaFruits(arena);
+
+    // --- Contiguous shares of bands: the caller takes the first one ---
+    int threads = config->threads;
+    if (threads > MAX_ARENA_THREADS) threads = MAX_ARENA_THREADS;
+    if (threads > arena->bandCount) threads = arena->bandCount;
+    if (threads < 1) threads = 1;
+    arena->workers = calloc((size_t)threads, sizeof(ArenaWorker));
+    if (!arena->workers)
+    {
+        FreeArena(arena);
+        return false;
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        arena->workers[i].arena = arena;
+        arena->workers[i].firstBand = (int)((long long)arena->bandCount * i / threads);
+        arena->workers[i].endBand = (int)((long long)arena->bandCount * (i + 1) / threads);
+    }
+    arena->threadCount = 1;
+    for (int i = 1; i < threads; i++)
+    {
+        if (thrd_create(&arena->workers[i].thread, ArenaWorkerMain, &arena->workers[i]) != thrd_success)
+        {
+            FreeArena(arena);
+            return false;
+        }
+        arena->threadCount++;
+    }
+    return true;
+}
+
+// === CHECKSUM ===
+// FNV-1a over every tile and every snake body
+uint32_t ArenaChecksum(const Arena* arena)
+{
+    uint32_t hash = 2166136261u;
+    for (int b = 0; b < arena->bandCount; b++)
+    {
+        const Board* board = &arena->bands[b].board;
+        for (int i = 0; i < board->columns * board->rows; i++)
+            hash = (hash ^ board->cells[i]) * 16777619u;
+    }
+    for (int i = 0; i < arena->snakeCount; i++)
+    {
+        const ArenaSnake* snake = &arena->snakes[i];
+        if (!snake->alive) continue;
+        for (int s = 0; s < snake->length; s++)
+        {
+            Cell cell = ArenaSegment(snake, s);
+            hash = (hash ^ (uint32_t)(cell.y * arena->columns + cell.x)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+// === FREE THE ARENA ===
+void FreeArena(Arena* arena)
+{
+    mtx_lock(&arena->lock);
+    arena->quit = true;
+    cnd_broadcast(&arena->start);
+    mtx_unlock(&arena->lock);
+    for (int i = 1; i < arena->threadCount; i++)
+        thrd_join(arena->workers[i].thread, NULL);
+
+    for (int b = 0; b < arena->bandCount; b++)
+    {
+        for (int c = 0; c < arena->bandCount; c++)
+            free(arena->bands[b].changes[c].items);
+        free(arena->bands[b].changes);
+        FreeBoard(&arena->bands[b].board);
+    }
+    for (int i = 0; i < arena->snakeCount; i++)
+        free(arena->snakes[i].cells);
+    free(arena->bands);
+    free(arena->claims);
+    free(arena->bandStart);
+    free(arena->order);
+    free(arena->snakes);
+    free(arena->workers);
+    cnd_destroy(&arena->finished);
+    cnd_destroy(&arena->start);
+    mtx_destroy(&arena->lock);
+    *arena = (Arena){ 0 };
+}
+
+// === NUMBER OF CPU CORES ===
+static int GetCoreCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+#endif
+}
+
+static double GetSeconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static void PrintArenaUsage(void)
+{
+    printf("usage: TheSnakeman --arena [--snakes N] [--board COLUMNSxROWS] [--ticks T]\n"
+           "                           [--fruits K] [--threads T] [--seed S]\n");
+}
+
+// === RUN THE ARENA MODE ===
+int RunArena(int argc, char** argv)
+{
+    ArenaConfig config = { 1000, 512, 512, 2000, (unsigned int)time(NULL), GetCoreCount() };
+    int ticks = 10000;
+
+    // --- Parse arguments ---
+    for (int i = 1; i < argc; i++)
+    {
+        const char* option = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = true;
+
+        if (strcmp(option, "--arena") == 0) continue;
+        else if (!value) ok = false;
+        else if (strcmp(option, "--snakes") == 0) config.snakes = atoi(value);
+        else if (strcmp(option, "--ticks") == 0) ticks = atoi(value);
+        else if (strcmp(option, "--fruits") == 0) config.fruits = atoi(value);
+        else if (strcmp(option, "--threads") == 0) config.threads = atoi(value);
+        else if (strcmp(option, "--seed") == 0) config.seed = (unsigned int)strtoul(value, NULL, 10);
+        else if (strcmp(option, "--board") == 0) ok = (sscanf(value, "%dx%d", &config.columns, &config.rows) == 2);
+        else ok = false;
+
+        if (!ok)
+        {
+            PrintArenaUsage();
+            return 1;
+        }
+        i++; // Skip the value
+    }
+
+    Arena arena;
+    if (ticks <= 0 || config.fruits < 0 || !InitArena(&arena, &config))
+    {
+        PrintArenaUsage();
+        return 1;
+    }
+
+    // --- Play ---
+    double start = GetSeconds();
+    for (int t = 0; t < ticks; t++)
+        StepArena(&arena);
+    double seconds = GetSeconds() - start;
+
+    // --- Report ---
+    bool failed = false;
+    int alive = 0, longest = 0;
+    for (int b = 0; b < arena.bandCount; b++) failed |= arena.bands[b].failed;
+    for (int i = 0; i < arena.snakeCount; i++)
+    {
+        if (!arena.snakes[i].alive) continue;
+        alive++;
+        if (arena.snakes[i].length > longest) longest = arena.snakes[i].length;
+    }
+
+    printf("%d snakes on a %dx%d board, %d threads, %d ticks, %.3f s\n",
+        arena.snakeCount, arena.columns, arena.rows, arena.threadCount, ticks, seconds);
+    printf("%.0f ticks/s, %.0f snake moves/s\n", ticks / seconds, (double)arena.stats.moves / seconds);
+    printf("%lld head-to-head deaths, %lld head-to-body deaths, %lld respawns, %lld fruits eaten\n",
+        arena.stats.headOnDeaths, arena.stats.bodyDeaths, arena.stats.respawns, arena.stats.fruitsEaten);
+    printf("%d alive, longest %d, checksum %08x%s\n", alive, longest, ArenaChecksum(&arena),
+        failed ? " (out of memory: some moves were lost)" : "");
+
+    FreeArena(&arena);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <threads.h>
+
+#include "board.h"   // Occupancy grid of each band
+#include "rng.h"     // Seeded random streams
+#include "sim.h"     // Cells and directions
+
+// === MULTI-SNAKE ARENA ===
+// Hundreds to thousands of bot snakes on one large board, headless. The board
+// is cut into bands of ARENA_BAND_ROWS rows, and each band is a Board of its
+// own with its own free list: threads owning different bands never write the
+// same memory. A tick runs in two parallel phases with a barrier between them:
+//   1. decide, then move: each living snake, grouped by the band of its head,
+//      picks a direction and claims the tile in front of it in the claim grid.
+//      Then a tile claimed by two heads kills all of them (head-to-head), a
+//      body or the border kills the snake running into it (head-to-body), the
+//      others move; every tile change is queued for the band it falls in. A
+//      head claims a tile at most one row away, so a thread only waits for the
+//      bands next to its share to finish claiming before moving its snakes;
+//   2. apply: each band applies the changes queued for it, band by band.
+// The board does not change before phase 2, so a tail still counts as body on
+// the tick it leaves its tile and no snake's fate depends on another surviving.
+// Claims are compared rather than raced and changes are applied in a fixed
+// order, so the same seed gives the same arena with any number of threads.
+//
+//   TheSnakeman --arena [--snakes N] [--board COLUMNSxROWS] [--ticks T]
+//                       [--fruits K] [--threads T] [--seed S]
+
+// === CONSTANTS ===
+#define ARENA_BAND_ROWS 16          // Rows of one band (the unit of work of a thread)
+#define ARENA_MAX_SNAKES 65535      // Snakes an arena can hold
+#define ARENA_RESPAWN_TICKS 30      // Ticks a dead snake waits before coming back
+#define ARENA_START_CAPACITY 16     // Segments allocated for a new snake (doubled when full)
+
+// === SETTINGS ===
+typedef struct ArenaConfig
+{
+    int snakes;              // Number of snakes
+    int columns;             // Board width in tiles
+    int rows;                // Board height in tiles
+    int fruits;              // Fruits kept on the board
+    unsigned int seed;       // Spawns and every snake's decisions
+    int threads;             // Threads stepping the bands, the caller's included (1 = no thread)
+} ArenaConfig;
+
+// === ONE SNAKE ===
+// Same circular buffer as Snake, but sized to the snake instead of the board
+typedef struct ArenaSnake
+{
+    Cell* cells;             // Segment i is at cells[(headIndex + i) % capacity]
+    int capacity;            // Cells allocated
+    int headIndex;           // Index of the head in the buffer
+    int length;              // Number of segments
+    int growth;              // Segments still to add
+    Direction direction;     // Current movement direction
+    Cell target;             // Tile the head goes to this tick
+    Rng random;              // Decisions, one stream per snake
+    bool alive;              // Dead snakes are off the board until respawnTick
+    int respawnTick;         // Tick a dead snake comes back at
+} ArenaSnake;
+
+// === TILE CHANGES QUEUED FOR ONE BAND ===
+// Each entry is a board index shifted left by two, or'ed with a CellType
+typedef struct ArenaChanges
+{
+    int* items;
+    int count;
+    int capacity;
+} ArenaChanges;
+
+// === ONE BAND OF ROWS ===
+typedef struct ArenaBand
+{
+    Board board;             // Tiles of rows [firstRow, firstRow + board.rows)
+    int firstRow;            // First board row of the band
+    ArenaChanges* changes;   // changes[b]: queued by the snakes of this band for band b
+    int eaten;               // Fruits eaten this tick by the snakes of this band
+    int headOnDeaths;        // Head-to-head deaths this tick
+    int bodyDeaths;          // Head-to-body and border deaths this tick
+    bool failed;             // A change could not be queued (out of memory)
+    _Atomic int claimedTick; // Last tick the snakes of this band have claimed their tiles for
+} ArenaBand;
+
+// === TOTALS SINCE THE START ===
+typedef struct ArenaStats
+{
+    long long moves;         // Snake moves
+    long long fruitsEaten;   // Fruits eaten
+    long long headOnDeaths;  // Snakes killed by another head on the same tile
+    long long bodyDeaths;    // Snakes killed by a body or the border
+    long long respawns;      // Dead snakes put back on the board
+} ArenaStats;
+
+struct Arena;
+
+// One thread and the bands it steps
+typedef struct ArenaWorker
+{
+    thrd_t thread;
+    struct Arena* arena;
+    int firstBand;           // First band of its share
+    int endBand;             // One past its last band
+} ArenaWorker;
+
+// Work of the phase being run
+typedef enum ArenaPhase
+{
+    ARENA_MOVE,              // Pick directions and claim tiles, then resolve conflicts, move and queue tile changes
+    ARENA_APPLY              // Apply the queued changes to the bands
+} ArenaPhase;
+
+// === ARENA STRUCT ===
+typedef struct Arena
+{
+    ArenaSnake* snakes;      // Every snake, living or not
+    int snakeCount;          // Number of snakes
+    ArenaBand* bands;        // Board bands, top to bottom
+    int bandCount;           // Number of bands
+    int columns;             // Board width in tiles
+    int rows;                // Board height in tiles
+    _Atomic uint64_t* claims; // Per tile: tick << 32 | claimer (snake + 1, or ARENA_CONTESTED)
+    int* order;              // Living snakes sorted by the band of their head
+    int* bandStart;          // Snakes of band b are order[bandStart[b]] to order[bandStart[b + 1] - 1]
+    int fruitCount;          // Fruits on the board
+    int fruitTarget;         // Fruits kept on the board
+    int tick;                // Ticks played
+    Rng random;              // Spawns of fruits and snakes
+    ArenaStats stats;        // Totals since the start
+
+    // Worker threads: they sleep until generation changes
+    ArenaWorker* workers;    // One per thread; workers[0] is the caller's share and has no thread
+    int threadCount;         // Threads stepping the bands, the caller's included
+    ArenaPhase phase;        // Phase the workers run
+    mtx_t lock;              // Protects generation, pending and quit
+    cnd_t start;             // Signalled when a phase begins
+    cnd_t finished;          // Signalled when the last worker is done
+    unsigned int generation; // Number of phases started
+    int pending;             // Workers still running the current phase
+    bool quit;               // Workers must exit
+} Arena;
+
+// === FUNCTION PROTOTYPES ===
+
+// Create the board, spawn the snakes and fruits and start the threads; returns false on failure
+bool InitArena(Arena* arena, const ArenaConfig* config);
+
+// Advance every snake by one tick
+void StepArena(Arena* arena);
+
+// Returns what occupies a tile (CELL_EMPTY if off the board)
+CellType GetArenaCell(const Arena* arena, Cell cell);
+
+// Returns the segment of a snake at the given index (0 = head)
+Cell ArenaSegment(const ArenaSnake* snake, int index);
+
+// Hash of the board and the snakes: equal seeds must give equal checksums at any thread count
+uint32_t ArenaChecksum(const Arena* arena);
+
+// Stop the threads and free the arena
+void FreeArena(Arena* arena);
+
+// Command-line mode: step an arena and print throughput and death statistics
+int RunArena(int argc, char** argv);
+
+#endif // ARENA_H
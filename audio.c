@@ -0,0 +1,205 @@
+#include <raylib.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include <time.h>
+
+#include "audio.h"
+#include "ressources.h"
+#include "trace.h"
+
+// === TRACK STATE (SERVICE SIDE ONLY) ===
+typedef struct ServiceTrack
+{
+    Music music;             // Copy of gameMusic[i], handed over by AUDIO_ATTACH
+    bool attached;           // The stream can be played
+    bool playing;            // Started and not stopped (paused included)
+    bool paused;             // Paused where it was
+    float volume;            // Current volume, 0 to 1
+    float fadeStep;          // Volume change per millisecond (negative: fading out, stops at 0)
+} ServiceTrack;
+
+static ServiceTrack tracks[MUSIC_NUMBER];
+
+// === COMMAND QUEUE ===
+// Written by the game thread (tail), read by the service (head)
+static AudioCommand commands[AUDIO_QUEUE_SIZE];
+static atomic_uint commandHead;
+static atomic_uint commandTail;
+
+// === SERVICE THREAD ===
+static thrd_t serviceThread;
+static bool serviceStarted = false;       // The thread exists (game thread only)
+static atomic_bool serviceQuit;           // The thread must return
+static double lastService = -1.0;         // Time of the previous refill (service side)
+
+// === APPLY ONE COMMAND ===
+static void ApplyAudioCommand(const AudioCommand* command)
+{
+    if (command->track < 0 || command->track >= MUSIC_NUMBER) return;
+    ServiceTrack* track = &tracks[command->track];
+    if (command->kind == AUDIO_ATTACH)
+    {
+        *track = (ServiceTrack){ .music = command->music, .attached = true, .volume = 1.0f };
+        track->music.looping = true;   // Every track of the game loops
+        return;
+    }
+    if (!track->attached) return;      // Not loaded: nothing to play
+
+    switch (command->kind)
+    {
+    case AUDIO_PLAY:
+    case AUDIO_CROSSFADE:
+        if (command->kind == AUDIO_CROSSFADE)
+        {
+            float fade = (command->fadeTime > 0.0f) ? command->fadeTime : 1.0f;
+            for (int i = 0; i < MUSIC_NUMBER; i++)
+            {
+                if (i == command->track || !tracks[i].playing) continue;
+                if (tracks[i].paused) // A paused track has nothing to fade
+                {
+                    StopMusicStream(tracks[i].music);
+                    tracks[i].playing = tracks[i].paused = false;
+                }
+                else tracks[i].fadeStep = -1.0f / fade;
+            }
+            track->volume = 0.0f;
+            track->fadeStep = 1.0f / fade;
+        }
+        else
+        {
+            track->volume = 1.0f;
+            track->fadeStep = 0.0f;
+        }
+        SetMusicVolume(track->music, track->volume);
+        PlayMusicStream(track->music);  // From the beginning
+        track->playing = true;
+        track->paused = false;
+        break;
+    case AUDIO_PAUSE:
+        if (track->playing && !track->paused) PauseMusicStream(track->music);
+        track->paused = track->playing;
+        break;
+    case AUDIO_RESUME:
+        if (track->paused) ResumeMusicStream(track->music);
+        track->paused = false;
+        break;
+    case AUDIO_STOP:
+        StopMusicStream(track->music);
+        track->playing = track->paused = false;
+        break;
+    default:
+        break;
+    }
+}
+
+// === ONE ROUND OF THE SERVICE ===
+// Commands first, then the fades and a refill of every playing stream
+static void ServiceAudio(void)
+{
+    unsigned int head = atomic_load_explicit(&commandHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&commandTail, memory_order_acquire);
+    while (head != tail)
+    {
+        ApplyAudioCommand(&commands[head % AUDIO_QUEUE_SIZE]);
+        head++;
+    }
+    atomic_store_explicit(&commandHead, head, memory_order_release);
+
+    double now = GetTime() * 1000.0;
+    float elapsed = (lastService < 0.0) ? 0.0f : (float)(now - lastService);
+    lastService = now;
+
+    for (int i = 0; i < MUSIC_NUMBER; i++)
+    {
+        ServiceTrack* track = &tracks[i];
+        if (!track->playing || track->paused) continue;
+        if (track->fadeStep != 0.0f)
+        {
+            track->volume += track->fadeStep * elapsed;
+            if (track->fadeStep < 0.0f && track->volume <= 0.0f) // Faded out
+            {
+                StopMusicStream(track->music);
+                track->playing = false;
+                track->volume = 1.0f;
+                track->fadeStep = 0.0f;
+                continue;
+            }
+            if (track->volume >= 1.0f)
+            {
+                track->volume = 1.0f;
+                track->fadeStep = 0.0f;
+            }
+            SetMusicVolume(track->music, track->volume);
+        }
+        UpdateMusicStream(track->music);  // Decode what the device will need next
+    }
+}
+
+// === SERVICE THREAD ===
+static int AudioServiceMain(void* argument)
+{
+    (void)argument;
+    struct timespec interval = { 0, AUDIO_SERVICE_INTERVAL * 1000000L };
+    while (!atomic_load(&serviceQuit))
+    {
+        TRACE_BEGIN("audio_service");
+        ServiceAudio();
+        TRACE_END();
+        thrd_sleep(&interval, NULL);
+    }
+    return 0;
+}
+
+// === START THE SERVICE ===
+void StartAudioService(void)
+{
+    atomic_init(&commandHead, 0u);
+    atomic_init(&commandTail, 0u);
+    atomic_init(&serviceQuit, false);
+    serviceStarted = (thrd_create(&serviceThread, AudioServiceMain, NULL) == thrd_success);
+    if (!serviceStarted)
+        TraceLog(LOG_WARNING, "AUDIO: No service thread, music is refilled once per frame");
+}
+
+// === QUEUE A COMMAND ===
+// The queue is only full if the service stalls: wait for it rather than lose a command
+static void PushAudioCommand(AudioCommand command)
+{
+    unsigned int tail = atomic_load_explicit(&commandTail, memory_order_relaxed);
+    while (tail - atomic_load_explicit(&commandHead, memory_order_acquire) >= AUDIO_QUEUE_SIZE)
+    {
+        if (serviceStarted) thrd_yield();
+        else ServiceAudio();   // The game thread is the service
+    }
+    commands[tail % AUDIO_QUEUE_SIZE] = command;
+    atomic_store_explicit(&commandTail, tail + 1, memory_order_release);
+}
+
+void SendAudioCommand(AudioCommandKind kind, int track, float fadeTime)
+{
+    PushAudioCommand((AudioCommand){ .kind = kind, .track = track, .fadeTime = fadeTime });
+}
+
+// === HAND OVER A LOADED TRACK ===
+void AttachMusic(int track, Music music)
+{
+    PushAudioCommand((AudioCommand){ .kind = AUDIO_ATTACH, .track = track, .music = music });
+}
+
+// === REFILL WITHOUT A THREAD ===
+void UpdateAudioService(void)
+{
+    if (!serviceStarted) ServiceAudio();
+}
+
+// === STOP THE SERVICE ===
+void StopAudioService(void)
+{
+    if (serviceStarted)
+    {
+        atomic_store(&serviceQuit, true);
+        thrd_join(serviceThread, NULL);
+        serviceStarted = false;
+    }
+    ServiceAudio();     // Commands queued after the last pass of the thread
+}
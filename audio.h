@@ -0,0 +1,60 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+// === MUSIC SERVICE THREAD ===
+// The music streams are decoded and refilled by a thread of their own, every
+// AUDIO_SERVICE_INTERVAL milliseconds, whatever the frame rate: a long frame
+// no longer starves the streams, and MP3 decoding no longer runs inside the
+// frame. The game thread never touches a playing stream; it sends commands
+// through a single-producer single-consumer lock-free queue, and the service
+// thread applies them in order before its next refill. A track is handed over
+// once loaded (AttachMusic), so the commands that follow can use it.
+//
+// Without a thread (creation failed) the same work is done by
+// UpdateAudioService() on the game thread, once per frame as before.
+
+// === CONSTANTS ===
+#define AUDIO_QUEUE_SIZE 32          // Commands waiting for the service thread (power of two)
+#define AUDIO_SERVICE_INTERVAL 10    // Milliseconds between two refills of the streams
+#define AUDIO_FADE_TIME 600.0f       // Milliseconds of a crossfade between two screens
+
+// === COMMANDS ===
+typedef enum AudioCommandKind
+{
+    AUDIO_ATTACH,            // A loaded track becomes playable
+    AUDIO_PLAY,              // Start a track from the beginning, looping, at full volume
+    AUDIO_PAUSE,             // Pause a track where it is
+    AUDIO_RESUME,            // Resume a paused track
+    AUDIO_STOP,              // Stop a track and rewind it
+    AUDIO_CROSSFADE          // Start a track from silence while every other one fades out and stops
+} AudioCommandKind;
+
+typedef struct AudioCommand
+{
+    AudioCommandKind kind;
+    int track;               // Index in gameMusic
+    float fadeTime;          // Milliseconds of the fade (AUDIO_CROSSFADE)
+    Music music;             // The loaded stream (AUDIO_ATTACH)
+} AudioCommand;
+
+// === FUNCTION PROTOTYPES ===
+
+// Start the service thread (after InitAudioDevice); without it the game thread does the work
+void StartAudioService(void);
+
+// Queue a command for the service thread (fadeTime in milliseconds, for AUDIO_CROSSFADE)
+void SendAudioCommand(AudioCommandKind kind, int track, float fadeTime);
+
+// Hand a loaded track to the service
+void AttachMusic(int track, Music music);
+
+// Refill the streams on the game thread when the service has no thread (once per frame)
+void UpdateAudioService(void);
+
+// Apply the last commands and join the thread: the streams can be unloaded after this
+void StopAudioService(void);
+
+#endif // AUDIO_H
@@ -0,0 +1,406 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "batch.h"
+#include "controller.h"
+#include "sim.h"
+
+// === CONSTANTS ===
+#define MAX_WORKERS 256          // Upper limit for --threads
+#define MAX_BATCH_CONTROLLERS 16 // Upper limit for --controllers
+#define BATCH_COLUMNS 15         // Default board: same as the window (960 / 64)
+#define BATCH_ROWS 15            // Default board: same as the window ((1024 - 64) / 64)
+
+// === RESULT OF ONE GAME ===
+typedef struct GameResult
+{
+    int controller;          // Index in the batch controller list
+    int score;               // Final score
+    int length;              // Final snake length
+    int steps;               // Steps played
+    bool won;                // Board filled
+    bool died;               // Crashed before the step limit
+} GameResult;
+
+// === BATCH SETTINGS SHARED BY ALL WORKERS ===
+typedef struct BatchConfig
+{
+    const Controller* controllers[MAX_BATCH_CONTROLLERS]; // Controllers in the tournament
+    int controllerCount;     // Number of controllers
+    int games;               // Games per controller
+    int threads;             // Number of worker threads
+    unsigned int seed;       // Seed of game 0; game i uses seed + i
+    int maxSteps;            // Steps after which a game is stopped
+    int columns;             // Board width in tiles
+    int rows;                // Board height in tiles
+    int fruits;              // Fruits kept on the board (1 = classic)
+} BatchConfig;
+
+// === WORKER ===
+// Each worker owns a range of jobs packed in one atomic word (end << 32 | next).
+// It takes jobs from the front of its range; when empty, it steals the back
+// half of another worker's range. Results go to a private buffer.
+typedef struct Worker
+{
+    thrd_t thread;
+    int id;
+    const BatchConfig* config;
+    _Atomic uint64_t range;  // Remaining jobs [next, end)
+    GameResult* results;     // Private result buffer
+    int resultCount;         // Number of results in the buffer
+    int resultCapacity;      // Allocated size of the buffer
+    struct Worker* all;      // Every worker, for stealing
+} Worker;
+
+static uint64_t PackRange(uint32_t next, uint32_t end)
+{
+    return ((uint64_t)end << 32) | next;
+}
+
+// === TAKE ONE JOB FROM THE OWN RANGE ===
+static bool TakeJob(Worker* worker, uint32_t* job)
+{
+    uint64_t range = atomic_load(&worker->range);
+    for (;;)
+    {
+        uint32_t next = (uint32_t)range;
+        uint32_t end = (uint32_t)(range >> 32);
+        if (next >= end) return false; // Nothing left
+
+        if (atomic_compare_exchange_weak(&worker->range, &range, PackRange(next + 1, end)))
+        {
+            *job = next;
+            return true;
+        }
+    }
+}
+
+// === STEAL HALF OF ANOTHER WORKER'S JOBS ===
+static bool StealJobs(Worker* worker)
+{
+    int count = worker->config->threads;
+    for (int i = 1; i < count; i++)
+    {
+        Worker* victim = &worker->all[(worker->id + i) % count];
+        uint64_t range = atomic_load(&victim->range);
+        for (;;)
+        {
+            uint32_t next = (uint32_t)range;
+            uint32_t end = (uint32_t)(range >> 32);
+            if (next >= end) break; // Victim is empty, try the next one
+
+            uint32_t middle = next + (end - next) / 2; // Victim keeps [next, middle)
+            if (atomic_compare_exchange_weak(&victim->range, &range, PackRange(next, middle)))
+            {
+                atomic_store(&worker->range, PackRange(middle, end));
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// === STORE A RESULT IN THE PRIVATE BUFFER ===
+static void AddResult(Worker* worker, GameResult result)
+{
+    if (worker->resultCount == worker->resultCapacity)
+    {
+        int capacity = (worker->resultCapacity == 0) ? 1024 : worker->resultCapacity * 2;
+        GameResult* results = realloc(worker->results, sizeof(GameResult) * (size_t)capacity);
+        if (!results) return; // Result is lost, the batch goes on
+        worker->results = results;
+        worker->resultCapacity = capacity;
+    }
+    worker->results[worker->resultCount++] = result;
+}
+
+// === WORKER THREAD ===
+static int WorkerMain(void* argument)
+{
+    Worker* worker = argument;
+    const BatchConfig* config = worker->config;
+
+    GameState game;
+    if (!InitGameState(&game, config->columns, config->rows, config->seed)) return 1;
+    SetFruitTarget(&game, config->fruits);
+
+    // Private data for each controller, reused across games. Without it this
+    // worker plays nothing: the others steal its jobs, or they are reported missing.
+    void* data[MAX_BATCH_CONTROLLERS];
+    bool created = true;
+    for (int i = 0; i < config->controllerCount; i++)
+    {
+        data[i] = config->controllers[i]->create(&game);
+        if (!data[i]) created = false;
+    }
+    if (!created)
+    {
+        fprintf(stderr, "worker %d: out of memory for the controllers\n", worker->id);
+        for (int i = 0; i < config->controllerCount; i++)
+            if (data[i]) config->controllers[i]->destroy(data[i]);
+        FreeGameState(&game);
+        return 1;
+    }
+
+    uint32_t job = 0;
+    while (TakeJob(worker, &job) || (StealJobs(worker) && TakeJob(worker, &job)))
+    {
+        int controller = (int)(job % (uint32_t)config->controllerCount);
+        unsigned int seed = config->seed + job / (uint32_t)config->controllerCount; // Same seeds for every controller
+        const Controller* player = config->controllers[controller];
+
+        SeedGameState(&game, seed);
+        ResetGameState(&game);
+        player->reset(data[controller], &game, seed);
+
+        int steps = 0; // One step is one tick: the snake moves one tile
+        while (!game.over && steps < config->maxSteps)
+        {
+            GameStep(&game, player->decide(data[controller], &game));
+            steps++;
+        }
+
+        AddResult(worker, (GameResult){ controller, game.score, game.snake.length, steps, game.won, game.over && !game.won });
+    }
+
+    for (int i = 0; i < config->controllerCount; i++)
+        config->controllers[i]->destroy(data[i]);
+    FreeGameState(&game);
+    return 0;
+}
+
+// === NUMBER OF CPU CORES ===
+static int GetCoreCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+#endif
+}
+
+static double GetSeconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static int CompareInts(const void* a, const void* b)
+{
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Value at a percentile of a sorted array
+static int Percentile(const int* values, int count, int percent)
+{
+    int index = (int)((long long)(count - 1) * percent / 100);
+    return values[index];
+}
+
+// === PRINT THE DISTRIBUTION OF ONE CONTROLLER ===
+static void PrintDistribution(const char* label, int* values, int count)
+{
+    long long sum = 0;
+    for (int i = 0; i < count; i++) sum += values[i];
+    qsort(values, (size_t)count, sizeof(int), CompareInts);
+
+    printf("  %-7s mean %8.2f  min %5d  p50 %5d  p90 %5d  p99 %5d  max %5d\n", label,
+        (double)sum / count, values[0], Percentile(values, count, 50),
+        Percentile(values, count, 90), Percentile(values, count, 99), values[count - 1]);
+}
+
+// === PRINT THE REPORT ===
+static void PrintReport(const BatchConfig* config, const GameResult* results, int resultCount, double seconds)
+{
+    int* scores = malloc(sizeof(int) * (size_t)resultCount);
+    int* lengths = malloc(sizeof(int) * (size_t)resultCount);
+    int* steps = malloc(sizeof(int) * (size_t)resultCount);
+    if (!scores || !lengths || !steps)
+    {
+        free(scores); free(lengths); free(steps);
+        return;
+    }
+
+    long long totalSteps = 0;
+    for (int i = 0; i < resultCount; i++) totalSteps += results[i].steps;
+
+    printf("%d games on a %dx%d board, %d threads, %.3f s\n",
+        resultCount, config->columns, config->rows, config->threads, seconds);
+    printf("%.0f games/s, %.0f steps/s\n\n", resultCount / seconds, (double)totalSteps / seconds);
+
+    for (int c = 0; c < config->controllerCount; c++)
+    {
+        int count = 0, won = 0, died = 0;
+        for (int i = 0; i < resultCount; i++)
+        {
+            if (results[i].controller != c) continue;
+            scores[count] = results[i].score;
+            lengths[count] = results[i].length;
+            steps[count] = results[i].steps;
+            won += results[i].won;
+            died += results[i].died;
+            count++;
+        }
+        if (count == 0) continue;
+
+        printf("%s: %d games, %d won, %d died, %d stopped at %d steps\n",
+            config->controllers[c]->name, count, won, died, count - won - died, config->maxSteps);
+        PrintDistribution("score", scores, count);
+        PrintDistribution("length", lengths, count);
+        PrintDistribution("steps", steps, count);
+        printf("\n");
+    }
+
+    free(scores);
+    free(lengths);
+    free(steps);
+}
+
+static void PrintUsage(void)
+{
+    printf("usage: TheSnakeman --batch [--games N] [--threads T] [--seed S]\n"
+           "                           [--controllers NAME,NAME...] [--max-steps M]\n"
+           "                           [--board COLUMNSxROWS] [--fruits K]\n"
+           "controllers:");
+    for (int i = 0; i < GetControllerCount(); i++)
+        printf(" %s", GetController(i)->name);
+    printf("\n");
+}
+
+// === PARSE THE CONTROLLER LIST ===
+static bool ParseControllers(BatchConfig* config, const char* list)
+{
+    char names[256];
+    snprintf(names, sizeof(names), "%s", list);
+
+    config->controllerCount = 0;
+    for (char* name = strtok(names, ","); name != NULL; name = strtok(NULL, ","))
+    {
+        const Controller* controller = FindController(name);
+        if (!controller || config->controllerCount == MAX_BATCH_CONTROLLERS)
+        {
+            fprintf(stderr, "unknown controller: %s\n", name);
+            return false;
+        }
+        config->controllers[config->controllerCount++] = controller;
+    }
+    return config->controllerCount > 0;
+}
+
+// === RUN THE BATCH MODE ===
+int RunBatch(int argc, char** argv)
+{
+    BatchConfig config = { 0 };
+    config.games = 1000;
+    config.threads = GetCoreCount();
+    config.seed = (unsigned int)time(NULL);
+    config.maxSteps = 100000;
+    config.columns = BATCH_COLUMNS;
+    config.rows = BATCH_ROWS;
+    config.fruits = 1;
+    for (int i = 0; i < GetControllerCount(); i++)
+        config.controllers[config.controllerCount++] = GetController(i);
+
+    // --- Parse arguments ---
+    for (int i = 1; i < argc; i++)
+    {
+        const char* option = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = true;
+
+        if (strcmp(option, "--batch") == 0) continue;
+        else if (!value) ok = false;
+        else if (strcmp(option, "--games") == 0) config.games = atoi(value);
+        else if (strcmp(option, "--threads") == 0) config.threads = atoi(value);
+        else if (strcmp(option, "--seed") == 0) config.seed = (unsigned int)strtoul(value, NULL, 10);
+        else if (strcmp(option, "--max-steps") == 0) config.maxSteps = atoi(value);
+        else if (strcmp(option, "--controllers") == 0) ok = ParseControllers(&config, value);
+        else if (strcmp(option, "--board") == 0) ok = (sscanf(value, "%dx%d", &config.columns, &config.rows) == 2);
+        else if (strcmp(option, "--fruits") == 0) config.fruits = atoi(value);
+        else ok = false;
+
+        if (!ok)
+        {
+            PrintUsage();
+            return 1;
+        }
+        i++; // Skip the value
+    }
+
+    long long jobCount = (long long)config.games * config.controllerCount;
+    if (config.games <= 0 || config.maxSteps <= 0 || jobCount > 0x7fffffff)
+    {
+        PrintUsage();
+        return 1;
+    }
+    if (config.threads < 1) config.threads = 1;
+    if (config.threads > MAX_WORKERS) config.threads = MAX_WORKERS;
+
+    // --- Split the jobs evenly; stealing balances the rest ---
+    Worker* workers = calloc((size_t)config.threads, sizeof(Worker));
+    if (!workers) return 1;
+    for (int i = 0; i < config.threads; i++)
+    {
+        uint32_t begin = (uint32_t)(jobCount * i / config.threads);
+        uint32_t end = (uint32_t)(jobCount * (i + 1) / config.threads);
+        workers[i].id = i;
+        workers[i].config = &config;
+        workers[i].all = workers;
+        atomic_init(&workers[i].range, PackRange(begin, end));
+    }
+
+    // --- Play ---
+    bool started[MAX_WORKERS] = { 0 };
+    double start = GetSeconds();
+    for (int i = 0; i < config.threads; i++)
+        started[i] = (thrd_create(&workers[i].thread, WorkerMain, &workers[i]) == thrd_success);
+    for (int i = 0; i < config.threads; i++)
+    {
+        if (started[i])
+            thrd_join(workers[i].thread, NULL);
+        else
+            WorkerMain(&workers[i]); // Could not start a thread: play its share here
+    }
+    double seconds = GetSeconds() - start;
+
+    // --- Merge the private result buffers ---
+    int resultCount = 0;
+    for (int i = 0; i < config.threads; i++) resultCount += workers[i].resultCount;
+
+    GameResult* results = malloc(sizeof(GameResult) * (size_t)(resultCount > 0 ? resultCount : 1));
+    int offset = 0;
+    for (int i = 0; i < config.threads; i++)
+    {
+        if (results && workers[i].resultCount > 0)
+            memcpy(results + offset, workers[i].results, sizeof(GameResult) * (size_t)workers[i].resultCount);
+        offset += workers[i].resultCount;
+        free(workers[i].results);
+    }
+
+    if (results && resultCount > 0)
+        PrintReport(&config, results, resultCount, seconds);
+
+    if (resultCount != jobCount)
+        fprintf(stderr, "%lld of %lld games were not played or not recorded\n", jobCount - resultCount, jobCount);
+
+    free(results);
+    free(workers);
+    return (resultCount == jobCount) ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// === BATCH SIMULATION ===
+// Command-line mode that plays many headless games in parallel with bot
+// controllers and prints score, length and throughput statistics:
+//
+//   TheSnakeman --batch [--games N] [--threads T] [--seed S]
+//                       [--controllers random,greedy] [--max-steps M]
+//                       [--board COLUMNSxROWS]
+
+// Run the batch mode with the program arguments; returns the process exit code
+int RunBatch(int argc, char** argv);
+
+#endif // BATCH_H
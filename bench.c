@@ -0,0 +1,541 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// The step functions are private to sim.c: the benchmark compiles it in
+// directly to time them one by one
+#include "sim.c"
+
+#include "board.h"
+#include "controller.h"
+#include "drawlist.h"
+#include "vecenv.h"
+#include "arena.h"
+#include "save.h"
+
+// === BENCHMARK SUITE ===
+// Times the simulation steps at growing snake lengths and fence counts, whole
+// bot games, the vectorized environment, the multi-snake arena, save files, and the headless draw list. Prints one line per result as CSV
+// (default) or a JSON array, so runs on two commits can be diffed:
+//
+//   bench [--format csv|json] [--quick] [--filter NAME]
+
+// === CONSTANTS ===
+#define LOOP_SIZE 16                // The snake loops over a LOOP_SIZE x LOOP_SIZE area
+#define FENCE_ROWS 8                // Rows under the loop where fences go
+#define BENCH_COLUMNS LOOP_SIZE     // Board of the step benchmarks
+#define BENCH_ROWS (LOOP_SIZE + FENCE_ROWS)
+#define SAMPLES 5                   // Timed samples per benchmark (the median is reported)
+#define MAX_RESULTS 128             // Results kept for the report
+#define GAME_COLUMNS 15             // Board of the game benchmarks (same as the window)
+#define GAME_ROWS 15
+#define VECENV_GAMES 256            // Games stepped together by the vecenv benchmarks
+#define ARENA_SNAKES 2048           // Snakes of the arena benchmarks
+#define ARENA_SIZE 512              // Width and height of the arena board
+#define SAVE_SIZE 1024              // Width and height of the board saved and loaded
+#define SAVE_BENCH_FILE "bench_save.sns" // Written next to the benchmark, removed at the end
+
+// === ONE RESULT ===
+typedef struct BenchResult
+{
+    char name[32];           // Benchmark name
+    int length;              // Snake length (0 if not relevant)
+    int fences;              // Fence count (0 if not relevant)
+    double nsPerOp;          // Median time of one operation
+    double nsMin;            // Fastest sample
+    double opsPerSecond;     // 1e9 / nsPerOp
+    long long operations;    // Operations in one sample
+} BenchResult;
+
+// === SUITE STATE ===
+static BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+static double sampleSeconds = 0.1;   // Minimum duration of one sample
+static const char* filter = NULL;    // Only run benchmarks containing this text
+
+static double GetSeconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static int CompareDoubles(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Keeps the compiler from dropping work whose result is unused
+static volatile unsigned int sink;
+
+// === LOOP OVER THE TOP OF THE BOARD ===
+// A cycle through every tile of the LOOP_SIZE x LOOP_SIZE area: rows are
+// swept back and forth from column 1, then column 0 leads back up. A snake
+// following it never runs into itself, whatever its length.
+static Direction loopDirection[BENCH_COLUMNS * BENCH_ROWS]; // Next direction from each tile
+static Cell loopCells[LOOP_SIZE * LOOP_SIZE];                // Tiles in loop order
+
+static void BuildLoop(void)
+{
+    int count = 0;
+    for (int y = 0; y < LOOP_SIZE; y++)
+    {
+        for (int i = 1; i < LOOP_SIZE; i++)
+            loopCells[count++] = (Cell){ (y % 2 == 0) ? i : LOOP_SIZE - i, y };
+    }
+    for (int y = LOOP_SIZE - 1; y >= 0; y--)
+        loopCells[count++] = (Cell){ 0, y };
+
+    for (int i = 0; i < count; i++)
+    {
+        Cell from = loopCells[i];
+        Cell to = loopCells[(i + 1) % count];
+        Direction direction = DIRECTION_UP;
+        if (to.x > from.x) direction = DIRECTION_RIGHT;
+        else if (to.x < from.x) direction = DIRECTION_LEFT;
+        else if (to.y > from.y) direction = DIRECTION_DOWN;
+        loopDirection[from.y * BENCH_COLUMNS + from.x] = direction;
+    }
+}
+
+// === STATE WITH A GIVEN LENGTH AND FENCE COUNT ===
+// The snake lies on the loop, head first, the fences fill the rows below
+static void SetupGame(GameState* game, int length, int fences)
+{
+    ResetGameState(game);
+    ClearFruits(game);
+    ClearBoard(&game->board);
+
+    Snake* snake = &game->snake;
+    snake->headIndex = 0;
+    snake->length = length;
+    snake->growth = 0;
+    for (int i = 0; i < length; i++)
+    {
+        snake->cells[i] = loopCells[(length - 1 - i) % (LOOP_SIZE * LOOP_SIZE)];
+        SetBoardCell(&game->board, snake->cells[i], CELL_BODY);
+    }
+    RestoreSnakeExits(game);
+    Cell head = snake->cells[0];
+    game->direction = loopDirection[head.y * BENCH_COLUMNS + head.x];
+    game->nextDirection = game->direction;
+
+    game->fenceCount = fences;
+    for (int i = 0; i < fences; i++)
+    {
+        game->fencePositions[i] = (Cell){ i % BENCH_COLUMNS, LOOP_SIZE + i / BENCH_COLUMNS };
+        SetBoardCell(&game->board, game->fencePositions[i], CELL_FENCE);
+    }
+}
+
+// Moves the head one tile along the loop
+static void LoopMove(GameState* game)
+{
+    Cell head = SnakeSegment(&game->snake, 0);
+    game->nextDirection = loopDirection[head.y * BENCH_COLUMNS + head.x];
+    SnakeMovement(game);
+}
+
+// === OPERATIONS ===
+typedef void (*BenchOperation)(GameState* game, long long count);
+
+static void OperationMove(GameState* game, long long count)
+{
+    for (long long i = 0; i < count; i++)
+        LoopMove(game);
+}
+
+// What GameStep() checks after a move: the tile the head landed on and the borders
+static void OperationCollision(GameState* game, long long count)
+{
+    unsigned int hits = 0;
+    for (long long i = 0; i < count; i++)
+    {
+        LoopMove(game);
+        Cell head = SnakeSegment(&game->snake, 0);
+        hits += game->snake.landedOn == CELL_BODY || game->snake.landedOn == CELL_FENCE ||
+            !BoardContains(&game->board, head);
+    }
+    sink = hits;
+}
+
+// Spawn then remove the fruit so the board stays the same
+static void OperationSpawn(GameState* game, long long count)
+{
+    for (long long i = 0; i < count; i++)
+    {
+        FruitSpawn(game);
+        ClearFruits(game);
+    }
+}
+
+// One growing move then a one-segment cut: the length stays the same
+static void OperationGrowShrink(GameState* game, long long count)
+{
+    for (long long i = 0; i < count; i++)
+    {
+        game->snake.growth = 1;
+        LoopMove(game);
+        ShrinkSnake(game, 1);
+    }
+}
+
+static DrawList drawList;
+
+static void OperationDrawList(GameState* game, long long count)
+{
+    for (long long i = 0; i < count; i++)
+    {
+        LoopMove(game);
+        BuildDrawList(&drawList, game, (BoardView){ 0, 0, BENCH_COLUMNS, BENCH_ROWS });
+    }
+    sink = (unsigned int)drawList.count;
+}
+
+// The list of each move compared with the one before: the tiles to repaint
+static DrawDiff drawDiff;
+
+static void OperationDrawDiff(GameState* game, long long count)
+{
+    BoardView view = { 0, 0, BENCH_COLUMNS, BENCH_ROWS };
+    for (long long i = 0; i < count; i++)
+    {
+        LoopMove(game);
+        BuildDrawList(&drawList, game, view);
+        sink += (unsigned int)DiffDrawList(&drawDiff, &drawList, view);
+    }
+}
+
+// === TIMING ===
+// Doubles the operation count until one sample lasts sampleSeconds, then
+// times SAMPLES samples of that size on a fresh state each
+static void RunBenchmark(const char* name, BenchOperation operation, GameState* game, int length, int fences)
+{
+    if (filter && !strstr(name, filter)) return;
+    if (resultCount == MAX_RESULTS) return;
+
+    long long count = 16;
+    for (;;)
+    {
+        SetupGame(game, length, fences);
+        double start = GetSeconds();
+        operation(game, count);
+        if (GetSeconds() - start >= sampleSeconds || count >= (1LL << 40)) break;
+        count *= 2;
+    }
+
+    double samples[SAMPLES];
+    for (int s = 0; s < SAMPLES; s++)
+    {
+        SetupGame(game, length, fences);
+        double start = GetSeconds();
+        operation(game, count);
+        samples[s] = (GetSeconds() - start) * 1e9 / (double)count;
+    }
+    qsort(samples, SAMPLES, sizeof(double), CompareDoubles);
+
+    BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->length = length;
+    result->fences = fences;
+    result->nsPerOp = samples[SAMPLES / 2];
+    result->nsMin = samples[0];
+    result->opsPerSecond = 1e9 / result->nsPerOp;
+    result->operations = count;
+    fprintf(stderr, "%-12s length %4d fences %3d  %10.2f ns/op\n", name, length, fences, result->nsPerOp);
+}
+
+// === WHOLE GAMES ===
+// Bot games from a fixed seed list until the time budget is used; reports ticks per second
+static void RunGameBenchmark(const char* controllerName)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "game_%s", controllerName);
+    if (filter && !strstr(name, filter)) return;
+    if (resultCount == MAX_RESULTS) return;
+
+    const Controller* controller = FindController(controllerName);
+    GameState game;
+    if (!controller || !InitGameState(&game, GAME_COLUMNS, GAME_ROWS, 1)) return;
+    void* data = controller->create(&game);
+
+    double samples[SAMPLES];
+    long long ticks = 0;
+    for (int s = 0; s < SAMPLES; s++)
+    {
+        ticks = 0;
+        unsigned int seed = 1;
+        double start = GetSeconds();
+        double elapsed = 0.0;
+        while (elapsed < sampleSeconds)
+        {
+            SeedGameState(&game, seed);
+            ResetGameState(&game);
+            controller->reset(data, &game, seed);
+            seed++;
+            while (!game.over && game.tickCounter < 100000)
+            {
+                GameStep(&game, controller->decide(data, &game));
+                ticks++;
+            }
+            elapsed = GetSeconds() - start;
+        }
+        samples[s] = elapsed * 1e9 / (double)ticks;
+    }
+    qsort(samples, SAMPLES, sizeof(double), CompareDoubles);
+
+    BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->length = 0;
+    result->fences = 0;
+    result->nsPerOp = samples[SAMPLES / 2];
+    result->nsMin = samples[0];
+    result->opsPerSecond = 1e9 / result->nsPerOp;
+    result->operations = ticks;
+    fprintf(stderr, "%-12s %10.0f ticks/s\n", name, result->opsPerSecond);
+
+    controller->destroy(data);
+    FreeGameState(&game);
+}
+
+// === VECTORIZED ENVIRONMENT ===
+// Random actions on VECENV_GAMES games; reports game ticks per second
+static void RunVecEnvBenchmark(int threads)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "vecenv_t%d", threads);
+    if (filter && !strstr(name, filter)) return;
+    if (resultCount == MAX_RESULTS) return;
+
+    VecEnvConfig config = { VECENV_GAMES, GAME_COLUMNS, GAME_ROWS, 1, 10000, threads };
+    VecEnv* env = CreateVecEnv(&config);
+    Direction* actions = malloc(sizeof(Direction) * VECENV_GAMES);
+    if (!env || !actions)
+    {
+        free(actions);
+        DestroyVecEnv(env);
+        return;
+    }
+
+    Rng random;
+    SeedRng(&random, 1, RNG_STREAM_CONTROLLER);
+    ResetVecEnv(env);
+
+    double samples[SAMPLES];
+    long long ticks = 0;
+    for (int s = 0; s < SAMPLES; s++)
+    {
+        ticks = 0;
+        double start = GetSeconds();
+        double elapsed = 0.0;
+        while (elapsed < sampleSeconds)
+        {
+            for (int i = 0; i < VECENV_GAMES; i++)
+            {
+                unsigned int value = NextRng(&random);
+                actions[i] = (value % 8 == 0) ? (Direction)((value >> 3) % 4) : DIRECTION_NONE;
+            }
+            StepVecEnv(env, actions);
+            ticks += VECENV_GAMES;
+            elapsed = GetSeconds() - start;
+        }
+        samples[s] = elapsed * 1e9 / (double)ticks;
+    }
+    qsort(samples, SAMPLES, sizeof(double), CompareDoubles);
+    sink += VecEnvDones(env)[0];
+
+    BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->length = 0;
+    result->fences = 0;
+    result->nsPerOp = samples[SAMPLES / 2];
+    result->nsMin = samples[0];
+    result->opsPerSecond = 1e9 / result->nsPerOp;
+    result->operations = ticks;
+    fprintf(stderr, "%-12s %10.0f ticks/s\n", name, result->opsPerSecond);
+
+    free(actions);
+    DestroyVecEnv(env);
+}
+
+// === MULTI-SNAKE ARENA ===
+// ARENA_SNAKES bots on one board; reports arena ticks per second
+static void RunArenaBenchmark(int threads)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "arena_t%d", threads);
+    if (filter && !strstr(name, filter)) return;
+    if (resultCount == MAX_RESULTS) return;
+
+    Arena arena;
+    ArenaConfig config = { ARENA_SNAKES, ARENA_SIZE, ARENA_SIZE, ARENA_SNAKES, 1, threads };
+    if (!InitArena(&arena, &config)) return;
+
+    double samples[SAMPLES];
+    long long ticks = 0;
+    for (int s = 0; s < SAMPLES; s++)
+    {
+        ticks = 0;
+        double start = GetSeconds();
+        double elapsed = 0.0;
+        while (elapsed < sampleSeconds)
+        {
+            StepArena(&arena);
+            ticks++;
+            elapsed = GetSeconds() - start;
+        }
+        samples[s] = elapsed * 1e9 / (double)ticks;
+    }
+    qsort(samples, SAMPLES, sizeof(double), CompareDoubles);
+    sink += ArenaChecksum(&arena);
+
+    BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->length = 0;
+    result->fences = 0;
+    result->nsPerOp = samples[SAMPLES / 2];
+    result->nsMin = samples[0];
+    result->opsPerSecond = 1e9 / result->nsPerOp;
+    result->operations = ticks;
+    fprintf(stderr, "%-12s %10.0f ticks/s\n", name, result->opsPerSecond);
+
+    FreeArena(&arena);
+}
+
+// === SAVE AND LOAD ===
+// Quick-save and quick-load of a SAVE_SIZE x SAVE_SIZE game; reports each per second
+static void RunSaveBenchmark(void)
+{
+    const char* names[2] = { "save", "load" };
+    if (filter && !strstr(names[0], filter) && !strstr(names[1], filter)) return;
+    if (resultCount + 2 > MAX_RESULTS) return;
+
+    GameState game;
+    if (!InitGameState(&game, SAVE_SIZE, SAVE_SIZE, 1)) return;
+
+    for (int n = 0; n < 2; n++)
+    {
+        double samples[SAMPLES];
+        long long operations = 0;
+        for (int s = 0; s < SAMPLES; s++)
+        {
+            operations = 0;
+            double start = GetSeconds();
+            double elapsed = 0.0;
+            while (elapsed < sampleSeconds)
+            {
+                bool ok = (n == 0) ? SaveGameState(&game, SAVE_BENCH_FILE) : LoadGameState(&game, SAVE_BENCH_FILE);
+                sink += ok;
+                operations++;
+                elapsed = GetSeconds() - start;
+            }
+            samples[s] = elapsed * 1e9 / (double)operations;
+        }
+        qsort(samples, SAMPLES, sizeof(double), CompareDoubles);
+
+        BenchResult* result = &results[resultCount++];
+        snprintf(result->name, sizeof(result->name), "%s", names[n]);
+        result->length = game.snake.length;
+        result->fences = game.fenceCount;
+        result->nsPerOp = samples[SAMPLES / 2];
+        result->nsMin = samples[0];
+        result->opsPerSecond = 1e9 / result->nsPerOp;
+        result->operations = operations;
+        fprintf(stderr, "%-12s %10.1f per second\n", names[n], result->opsPerSecond);
+    }
+
+    remove(SAVE_BENCH_FILE);
+    FreeGameState(&game);
+}
+
+// === REPORT ===
+static void PrintResults(bool json)
+{
+    if (json)
+    {
+        printf("[\n");
+        for (int i = 0; i < resultCount; i++)
+        {
+            const BenchResult* r = &results[i];
+            printf("  {\"name\": \"%s\", \"length\": %d, \"fences\": %d, \"ns_per_op\": %.3f, "
+                "\"ns_min\": %.3f, \"ops_per_second\": %.1f, \"operations\": %lld}%s\n",
+                r->name, r->length, r->fences, r->nsPerOp, r->nsMin, r->opsPerSecond, r->operations,
+                (i + 1 < resultCount) ? "," : "");
+        }
+        printf("]\n");
+    }
+    else
+    {
+        printf("name,length,fences,ns_per_op,ns_min,ops_per_second,operations\n");
+        for (int i = 0; i < resultCount; i++)
+        {
+            const BenchResult* r = &results[i];
+            printf("%s,%d,%d,%.3f,%.3f,%.1f,%lld\n", r->name, r->length, r->fences,
+                r->nsPerOp, r->nsMin, r->opsPerSecond, r->operations);
+        }
+    }
+}
+
+// === ENTRY POINT ===
+int main(int argc, char** argv)
+{
+    bool json = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) json = strcmp(argv[++i], "json") == 0;
+        else if (strcmp(argv[i], "--quick") == 0) sampleSeconds = 0.01;
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--format csv|json] [--quick] [--filter NAME]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    BuildLoop();
+    GameState game;
+    if (!InitGameState(&game, BENCH_COLUMNS, BENCH_ROWS, 1) || !InitDrawList(&drawList, BENCH_COLUMNS, BENCH_ROWS)
+        || !InitDrawDiff(&drawDiff, BENCH_COLUMNS, BENCH_ROWS))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // From a new snake to one filling the whole loop; fences from none to the maximum
+    const int lengths[] = { START_LENGTH, 16, 64, 128, LOOP_SIZE * LOOP_SIZE };
+    const int fenceCounts[] = { 0, MAX_FENCES / 4, MAX_FENCES };
+    int lengthCount = (int)(sizeof(lengths) / sizeof(lengths[0]));
+    int fenceCountCount = (int)(sizeof(fenceCounts) / sizeof(fenceCounts[0]));
+
+    for (int l = 0; l < lengthCount; l++)
+    {
+        RunBenchmark("move", OperationMove, &game, lengths[l], 0);
+        RunBenchmark("grow_shrink", OperationGrowShrink, &game, lengths[l] - 1, 0); // Room for the extra segment
+        RunBenchmark("draw_list", OperationDrawList, &game, lengths[l], MAX_FENCES);
+        RunBenchmark("draw_diff", OperationDrawDiff, &game, lengths[l], MAX_FENCES);
+        for (int f = 0; f < fenceCountCount; f++)
+        {
+            RunBenchmark("collision", OperationCollision, &game, lengths[l], fenceCounts[f]);
+            RunBenchmark("fruit_spawn", OperationSpawn, &game, lengths[l] - 1, fenceCounts[f]); // A free tile for the fruit
+        }
+    }
+    RunGameBenchmark("greedy");
+    RunGameBenchmark("random");
+    RunGameBenchmark("autopilot");
+    RunVecEnvBenchmark(1);
+    RunVecEnvBenchmark(4);
+    RunArenaBenchmark(1);
+    RunArenaBenchmark(4);
+    RunSaveBenchmark();
+
+    PrintResults(json);
+
+    FreeDrawList(&drawList);
+    FreeDrawDiff(&drawDiff);
+    FreeGameState(&game);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board.h"
+
+#define CELL_CHECKED 0xFF   // Temporary mark of SetBoardFreeOrder()
+
+// === INITIALIZE BOARD ===
+// One cell per tile below the white HUD bar
+bool InitBoard(Board* board, int columns, int rows)
+{
+    *board = (Board){ 0 };
+    board->columns = columns;
+    board->rows = rows;
+
+    size_t cellCount = (size_t)columns * (size_t)rows;
+    board->cells = malloc(cellCount);
+    board->freeCells = malloc(sizeof(int) * cellCount);
+    board->freeSlot = malloc(sizeof(int) * cellCount);
+
+    if (!board->cells || !board->freeCells || !board->freeSlot)
+    {
+        FreeBoard(board);    // Empty board to indicate failure
+        return false;
+    }
+    ClearBoard(board);
+    return true;
+}
+
+// === CLEAR BOARD ===
+void ClearBoard(Board* board)
+{
+    if (!board->cells) return;
+
+    int cellCount = board->columns * board->rows;
+    memset(board->cells, CELL_EMPTY, (size_t)cellCount);
+
+    // Every cell is free again
+    for (int i = 0; i < cellCount; i++)
+    {
+        board->freeCells[i] = i;
+        board->freeSlot[i] = i;
+    }
+    board->freeCount = cellCount;
+}
+
+// === CHECK IF A CELL IS ON THE BOARD ===
+bool BoardContains(const Board* board, Cell cell)
+{
+    return cell.x >= 0 && cell.x < board->columns &&
+           cell.y >= 0 && cell.y < board->rows;
+}
+
+// === CONVERT A CELL TO AN INDEX ===
+int BoardIndex(const Board* board, Cell cell)
+{
+    if (!BoardContains(board, cell)) return -1; // Off the board
+    return cell.y * board->columns + cell.x;
+}
+
+// === CONVERT AN INDEX TO A CELL ===
+Cell BoardCell(const Board* board, int index)
+{
+    return (Cell){ index % board->columns, index / board->columns };
+}
+
+// === READ A CELL ===
+CellType GetBoardCell(const Board* board, Cell cell)
+{
+    int index = BoardIndex(board, cell);
+    return (index < 0) ? CELL_EMPTY : (CellType)board->cells[index];
+}
+
+// === WRITE A CELL ===
+void SetBoardCell(Board* board, Cell cell, CellType type)
+{
+    int index = BoardIndex(board, cell);
+    if (index < 0) return; // Off the board
+
+    bool wasFree = (board->cells[index] == CELL_EMPTY);
+    board->cells[index] = (unsigned char)type;
+
+    if (wasFree && type != CELL_EMPTY)
+    {
+        // Remove from the free list: move the last free cell into its slot
+        int slot = board->freeSlot[index];
+        int last = board->freeCells[--board->freeCount];
+        board->freeCells[slot] = last;
+        board->freeSlot[last] = slot;
+        board->freeSlot[index] = -1;
+    }
+    else if (!wasFree && type == CELL_EMPTY)
+    {
+        // Append to the free list
+        board->freeCells[board->freeCount] = index;
+        board->freeSlot[index] = board->freeCount;
+        board->freeCount++;
+    }
+}
+
+// === PICK A RANDOM EMPTY CELL ===
+bool RandomFreeCell(const Board* board, unsigned int random, Cell* cell)
+{
+    if (board->freeCount == 0) return false; // Board is full
+
+    int slot = (int)(((uint64_t)random * (uint32_t)board->freeCount) >> 32); // Multiply-shift: no division
+    *cell = BoardCell(board, board->freeCells[slot]);
+    return true;
+}
+
+// === RESTORE THE ORDER OF THE FREE LIST ===
+// RandomFreeCell() depends on the order of the list, not only on which cells
+// are free, so a restored game must get back the exact order it was saved with
+bool SetBoardFreeOrder(Board* board, const int* freeCells, int count)
+{
+    if (count != board->freeCount) return false;
+
+    // Every saved cell must be free and listed once: mark them while checking
+    int cellCount = board->columns * board->rows;
+    int marked = 0;
+    while (marked < count)
+    {
+        int index = freeCells[marked];
+        if (index < 0 || index >= cellCount || board->cells[index] != CELL_EMPTY) break;
+        board->cells[index] = CELL_CHECKED;
+        marked++;
+    }
+    for (int i = 0; i < marked; i++)
+        board->cells[freeCells[i]] = CELL_EMPTY;  // Remove the marks
+    if (marked != count) return false;
+
+    for (int i = 0; i < count; i++)
+    {
+        board->freeCells[i] = freeCells[i];
+        board->freeSlot[freeCells[i]] = i;
+    }
+    return true;
+}
+
+// === FREE BOARD MEMORY ===
+void FreeBoard(Board* board)
+{
+    free(board->cells);      // Free the grid
+    free(board->freeCells);  // Free the free-cell list
+    free(board->freeSlot);   // Free the reverse index
+    *board = (Board){ 0 };   // Reset the board
+}
@@ -0,0 +1,72 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+// === CELL COORDINATES ===
+// Position of a tile on the board, in tiles (not pixels)
+typedef struct Cell
+{
+    int x;                   // Column, 0 = left edge
+    int y;                   // Row, 0 = first row under the HUD bar
+} Cell;
+
+// === CELL TYPES ===
+// What currently occupies a tile of the board
+typedef enum CellType
+{
+    CELL_EMPTY,    // Nothing on this tile
+    CELL_BODY,     // A snake segment (head included)
+    CELL_FENCE,    // A fence
+    CELL_FRUIT     // A fruit (the game finds which one with its fruit slots)
+} CellType;
+
+// === BOARD STRUCT ===
+// Occupancy grid with one cell per tile of the playing field (HUD bar excluded).
+// Empty cells are also listed in freeCells so a random one can be drawn in O(1):
+// freeSlot[cell] is the position of the cell in freeCells (-1 when occupied),
+// and removing a cell swaps the last entry of the list into its slot.
+typedef struct Board
+{
+    unsigned char* cells;    // columns * rows cell types, row by row
+    int* freeCells;          // Indices of the empty cells (first freeCount entries)
+    int* freeSlot;           // Reverse index: slot of each cell in freeCells, or -1
+    int freeCount;           // Number of empty cells
+    int columns;             // Number of tiles horizontally
+    int rows;                // Number of tiles vertically
+} Board;
+
+// === FUNCTION PROTOTYPES ===
+
+// Allocate a grid of the given size; returns false on allocation failure
+bool InitBoard(Board* board, int columns, int rows);
+
+// Mark every cell of the board as empty
+void ClearBoard(Board* board);
+
+// Returns true if the cell lies on the board
+bool BoardContains(const Board* board, Cell cell);
+
+// Returns the index of a cell, or -1 if it is off the board
+int BoardIndex(const Board* board, Cell cell);
+
+// Returns the cell at an index
+Cell BoardCell(const Board* board, int index);
+
+// Returns what occupies a cell (CELL_EMPTY if off the board)
+CellType GetBoardCell(const Board* board, Cell cell);
+
+// Sets what occupies a cell (ignored if off the board)
+void SetBoardCell(Board* board, Cell cell, CellType type);
+
+// Picks the empty cell selected by 32 random bits; returns false when the board is full
+bool RandomFreeCell(const Board* board, unsigned int random, Cell* cell);
+
+// Reorder the free list to match a saved one; returns false if the free cells differ
+bool SetBoardFreeOrder(Board* board, const int* freeCells, int count);
+
+// Free the grid memory
+void FreeBoard(Board* board);
+
+#endif // BOARD_H
@@ -0,0 +1,385 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "controller.h"
+#include "sim.h"
+#include "board.h"
+#include "rng.h"
+#include "pathfield.h"
+
+// Movement of one tile for each direction
+static const Cell turnDelta[4] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+
+// === SHARED PRIVATE DATA ===
+// The simple controllers only need their own random stream
+typedef struct SimpleData
+{
+    Rng random;              // Controller stream, independent from the game's
+} SimpleData;
+
+static void* CreateSimple(const GameState* game)
+{
+    (void)game;
+    return calloc(1, sizeof(SimpleData));
+}
+
+static void ResetSimple(void* data, const GameState* game, unsigned int seed)
+{
+    (void)game;
+    SeedRng(&((SimpleData*)data)->random, seed, RNG_STREAM_CONTROLLER);
+}
+
+static void DestroySimple(void* data)
+{
+    free(data);
+}
+
+// === CHECK IF A MOVE IS SAFE ===
+// The next head tile must be on the board and free; the tail tile is fine
+// when the snake is not growing since the tail leaves it on the same move
+static bool IsSafeMove(const GameState* game, Direction turn)
+{
+    Cell head = SnakeSegment(&game->snake, 0);
+    Cell next = { head.x + turnDelta[turn].x, head.y + turnDelta[turn].y };
+    if (!BoardContains(&game->board, next)) return false;
+
+    CellType type = GetBoardCell(&game->board, next);
+    if (type == CELL_FENCE) return false;
+    if (type == CELL_BODY)
+    {
+        Cell tail = SnakeSegment(&game->snake, game->snake.length - 1);
+        return game->snake.growth == 0 && next.x == tail.x && next.y == tail.y;
+    }
+    return true;
+}
+
+// === RANDOM CONTROLLER ===
+// Turns at random now and then, ignoring the danger
+static GameInput DecideRandom(void* data, const GameState* game)
+{
+    (void)game;
+    GameInput input = { DIRECTION_NONE };
+    unsigned int value = NextRng(&((SimpleData*)data)->random);
+    if (value % 8 == 0)
+        input.turn = (Direction)((value >> 3) % 4);
+    return input;
+}
+
+// === GREEDY CONTROLLER ===
+// Takes the safe direction that gets closest to the nearest fruit
+static GameInput DecideGreedy(void* data, const GameState* game)
+{
+    GameInput input = { DIRECTION_NONE };
+    Cell head = SnakeSegment(&game->snake, 0);
+    Cell target = head;
+    int nearest = 0x7fffffff;
+    for (int i = 0; i < game->fruitCount; i++)
+    {
+        Cell fruit = game->fruits[i].position;
+        int distance = abs(fruit.x - head.x) + abs(fruit.y - head.y);
+        if (distance < nearest)
+        {
+            nearest = distance;
+            target = fruit;
+        }
+    }
+    Direction reverse = (Direction)((game->direction + 2) % 4);
+
+    int bestScore = 0x7fffffff;
+    unsigned int tieBreak = NextRng(&((SimpleData*)data)->random);
+    for (int i = 0; i < 4; i++)
+    {
+        Direction turn = (Direction)((i + tieBreak) % 4); // Start at a random direction to break ties
+        if (turn == reverse || !IsSafeMove(game, turn)) continue;
+
+        Cell next = { head.x + turnDelta[turn].x, head.y + turnDelta[turn].y };
+        int distance = abs(target.x - next.x) + abs(target.y - next.y);
+        if (distance < bestScore)
+        {
+            bestScore = distance;
+            input.turn = turn;
+        }
+    }
+
+    if (input.turn == game->direction) input.turn = DIRECTION_NONE; // Keep going
+    return input;
+}
+
+// === AUTOPILOT CONTROLLER ===
+// Follows a distance field to the nearest fruit and only takes a move after which the
+// tail can still be reached, so the snake does not wall itself in. The field
+// is updated with the tiles that changed since the last tick; the tail search
+// stops after AUTOPILOT_VISIT_BUDGET cells so a decision always costs the same.
+// When it has gone a long time without eating it takes more risks to reach
+// the fruit, so every game ends.
+typedef struct AutopilotData
+{
+    PathField field;         // Moves from every tile to the nearest fruit
+    unsigned int* visited;   // Search stamp of each tile seen by the tail search
+    int* queue;              // Tail search queue
+    unsigned int stamp;      // Stamp of the current tail search
+    bool synced;             // The field matches the game as it was at lastTick
+    int lastTick;            // Tick the field was last brought up to
+    int lastHeadIndex;       // Snake buffer slot of the head at lastTick
+    int lastLength;          // Snake length at lastTick
+    int lastFenceCount;      // Number of fences at lastTick
+    int progressScore;       // Score when the snake last ate
+    int progressTick;        // Tick it last ate (or the game started)
+} AutopilotData;
+
+static void DestroyAutopilot(void* data)
+{
+    AutopilotData* pilot = data;
+    if (!pilot) return;
+    FreePathField(&pilot->field);
+    free(pilot->visited);
+    free(pilot->queue);
+    free(pilot);
+}
+
+static void* CreateAutopilot(const GameState* game)
+{
+    AutopilotData* pilot = calloc(1, sizeof(AutopilotData));
+    if (!pilot) return NULL;
+
+    size_t cellCount = (size_t)game->board.columns * (size_t)game->board.rows;
+    pilot->visited = calloc(cellCount, sizeof(unsigned int));
+    pilot->queue = malloc(sizeof(int) * cellCount);
+    if (!InitPathField(&pilot->field, game->board.columns, game->board.rows) ||
+        !pilot->visited || !pilot->queue)
+    {
+        DestroyAutopilot(pilot);
+        return NULL;
+    }
+    return pilot;
+}
+
+static void ResetAutopilot(void* data, const GameState* game, unsigned int seed)
+{
+    (void)seed;
+    AutopilotData* pilot = data;
+    pilot->synced = false;   // Rebuilt on the first decision
+    pilot->progressScore = game->score;
+    pilot->progressTick = game->tickCounter;
+}
+
+// === BRING THE FIELD UP TO DATE ===
+// One tick moves the head onto one tile and the tail off at most a few, so
+// only those tiles change; the head closing a fruit tile drops that target
+// and the fruits spawned since become targets. Anything else (new game,
+// skipped ticks) rebuilds the field.
+static void SyncAutopilot(AutopilotData* pilot, const GameState* game)
+{
+    const Snake* snake = &game->snake;
+    const Board* board = &game->board;
+    if (pilot->synced && game->tickCounter == pilot->lastTick) return; // Already done
+
+    if (!pilot->synced || game->tickCounter != pilot->lastTick + 1 ||
+        game->fenceCount < pilot->lastFenceCount || pilot->lastLength >= snake->capacity)
+    {
+        BuildPathField(&pilot->field, board);
+    }
+    else
+    {
+        // Old segments past the new tail were left behind (unless the head came back on them)
+        for (int i = snake->length - 1; i < pilot->lastLength; i++)
+        {
+            Cell cell = snake->cells[(pilot->lastHeadIndex + i) % snake->capacity];
+            CellType type = GetBoardCell(board, cell);
+            if (type != CELL_BODY && type != CELL_FENCE)
+                OpenPathCell(&pilot->field, BoardIndex(board, cell));
+        }
+        for (int i = pilot->lastFenceCount; i < game->fenceCount; i++)
+            ClosePathCell(&pilot->field, BoardIndex(board, game->fencePositions[i]));
+
+        int head = BoardIndex(board, SnakeSegment(snake, 0));
+        if (head >= 0) ClosePathCell(&pilot->field, head);
+        for (int i = 0; i < game->fruitCount; i++)
+            AddPathTarget(&pilot->field, BoardIndex(board, game->fruits[i].position)); // Known ones return at once
+    }
+
+    pilot->synced = true;
+    pilot->lastTick = game->tickCounter;
+    pilot->lastHeadIndex = snake->headIndex;
+    pilot->lastLength = snake->length;
+    pilot->lastFenceCount = game->fenceCount;
+}
+
+// === CHECK THAT THE TAIL STAYS REACHABLE ===
+// Breadth-first search from the tile the head would move to. While a path to
+// the tail exists the snake can always follow it and wait for room to open.
+// Every cell looked at uses one unit of the budget; when it runs out the room
+// found so far is taken as enough. area receives the number of tiles reached.
+static bool TailReachable(AutopilotData* pilot, const GameState* game, Cell next, int* budget, int* area)
+{
+    const Snake* snake = &game->snake;
+    const Board* board = &game->board;
+    bool tailMoves = (snake->growth == 0);     // Tail leaves its tile on this move
+    int oldTail = BoardIndex(board, SnakeSegment(snake, snake->length - 1));
+    int tail = BoardIndex(board, SnakeSegment(snake, snake->length - (tailMoves ? 2 : 1)));
+    if (!tailMoves) oldTail = -1;
+
+    int columns = board->columns;
+    int cellCount = board->columns * board->rows;
+    if (++pilot->stamp == 0)
+    {
+        // Stamps wrapped around: forget every old search
+        memset(pilot->visited, 0, sizeof(unsigned int) * (size_t)cellCount);
+        pilot->stamp = 1;
+    }
+
+    int start = BoardIndex(board, next);
+    int head = 0;
+    int count = 0;
+    pilot->visited[start] = pilot->stamp;
+    pilot->queue[count++] = start;
+    while (head < count)
+    {
+        if (*budget <= 0)
+        {
+            *area = count;
+            return true;
+        }
+        (*budget)--;
+
+        int cell = pilot->queue[head++];
+        int x = cell % columns;
+        int neighbours[4] = {
+            (cell >= columns) ? cell - columns : -1,               // Up
+            (x + 1 < columns) ? cell + 1 : -1,                     // Right
+            (cell + columns < cellCount) ? cell + columns : -1,    // Down
+            (x > 0) ? cell - 1 : -1                                // Left
+        };
+        for (int i = 0; i < 4; i++)
+        {
+            int index = neighbours[i];
+            if (index < 0 || pilot->visited[index] == pilot->stamp) continue;
+            if (index == tail)
+            {
+                *area = count;
+                return true;
+            }
+            unsigned char type = board->cells[index];
+            if (type == CELL_FENCE || (type == CELL_BODY && index != oldTail)) continue;
+            pilot->visited[index] = pilot->stamp;
+            pilot->queue[count++] = index;
+        }
+    }
+    *area = count;
+    return false;
+}
+
+// === STRAIGHT-LINE DISTANCE TO THE NEAREST FRUIT ===
+// Used when the body cuts every path: moving that way opens one up sooner
+static int FruitHeading(const GameState* game, Cell cell)
+{
+    int nearest = game->board.columns + game->board.rows;
+    for (int i = 0; i < game->fruitCount; i++)
+    {
+        Cell fruit = game->fruits[i].position;
+        int distance = abs(fruit.x - cell.x) + abs(fruit.y - cell.y);
+        if (distance < nearest) nearest = distance;
+    }
+    return nearest;
+}
+
+static GameInput DecideAutopilot(void* data, const GameState* game)
+{
+    AutopilotData* pilot = data;
+    GameInput input = { DIRECTION_NONE };
+    SyncAutopilot(pilot, game);
+
+    // Safe moves sorted by distance to the nearest fruit; going straight wins ties
+    int cellCount = game->board.columns * game->board.rows;
+    Cell head = SnakeSegment(&game->snake, 0);
+    Direction reverse = (Direction)((game->direction + 2) % 4);
+    Direction moves[3];
+    int distances[3];
+    int moveCount = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        Direction turn = (Direction)((game->direction + i) % 4);
+        if (turn == reverse || !IsSafeMove(game, turn)) continue;
+
+        Cell next = { head.x + turnDelta[turn].x, head.y + turnDelta[turn].y };
+        int distance = PathDistance(&pilot->field, next);
+        if (distance == PATH_UNREACHABLE)
+            distance = cellCount + FruitHeading(game, next); // Walled off by the body: head the right way
+        int slot = moveCount++;
+        while (slot > 0 && distances[slot - 1] > distance)
+        {
+            moves[slot] = moves[slot - 1];
+            distances[slot] = distances[slot - 1];
+            slot--;
+        }
+        moves[slot] = turn;
+        distances[slot] = distance;
+    }
+
+    // Following the tail can go round forever while the fruit stays out of
+    // safe reach: after a board's worth of ticks without eating, the closest
+    // move is taken whenever it leaves room for the whole snake, and after
+    // twice that it is taken anyway (a fruit at the end of a dead end is
+    // eaten at the cost of the game rather than circled for ever)
+    if (game->score != pilot->progressScore || game->tickCounter < pilot->progressTick)
+    {
+        pilot->progressScore = game->score;
+        pilot->progressTick = game->tickCounter;
+    }
+    int stalledTicks = game->tickCounter - pilot->progressTick;
+    int neededArea = cellCount + 1;              // More than any move has: the tail rule alone
+    if (stalledTicks > cellCount) neededArea = game->snake.length;
+    if (stalledTicks > 2 * cellCount) neededArea = 0;
+
+    // Closest move that keeps the tail in reach; when trapped, the one with the most room
+    int budget = AUTOPILOT_VISIT_BUDGET;
+    int bestArea = -1;
+    Direction choice = DIRECTION_NONE;
+    for (int i = 0; i < moveCount; i++)
+    {
+        Cell next = { head.x + turnDelta[moves[i]].x, head.y + turnDelta[moves[i]].y };
+        int area = 0;
+        if (TailReachable(pilot, game, next, &budget, &area) || (i == 0 && area >= neededArea))
+        {
+            choice = moves[i];
+            break;
+        }
+        if (area > bestArea)
+        {
+            bestArea = area;
+            choice = moves[i];
+        }
+    }
+
+    if (choice != game->direction) input.turn = choice; // Otherwise keep going
+    return input;
+}
+
+// === BUILT-IN CONTROLLERS ===
+static const Controller controllers[] = {
+    { "random", CreateSimple, ResetSimple, DecideRandom, DestroySimple },
+    { "greedy", CreateSimple, ResetSimple, DecideGreedy, DestroySimple },
+    { "autopilot", CreateAutopilot, ResetAutopilot, DecideAutopilot, DestroyAutopilot },
+};
+
+#define CONTROLLER_NUMBER ((int)(sizeof(controllers) / sizeof(controllers[0])))
+
+const Controller* FindController(const char* name)
+{
+    for (int i = 0; i < CONTROLLER_NUMBER; i++)
+    {
+        if (strcmp(controllers[i].name, name) == 0)
+            return &controllers[i];
+    }
+    return NULL;
+}
+
+int GetControllerCount(void)
+{
+    return CONTROLLER_NUMBER;
+}
+
+const Controller* GetController(int index)
+{
+    return (index >= 0 && index < CONTROLLER_NUMBER) ? &controllers[index] : NULL;
+}
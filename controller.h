@@ -0,0 +1,35 @@
+#ifndef CONTROLLER_H
+#define CONTROLLER_H
+
+#include <stdlib.h>
+
+#include "sim.h"     // Game state and input
+
+// === CONSTANTS ===
+#define AUTOPILOT_VISIT_BUDGET 2048  // Tiles the autopilot may search per tick (a few microseconds)
+
+// === CONTROLLERS ===
+// A controller plays in place of SnakeDirectionInput(): it looks at the game
+// state and returns the turn to apply on the next step. Each one keeps its own
+// private data so several games can be played at the same time.
+typedef struct Controller
+{
+    const char* name;                                          // Name used on the command line
+    void* (*create)(const GameState* game);                    // Allocate private data for one worker
+    void (*reset)(void* data, const GameState* game, unsigned int seed); // Prepare for a new game
+    GameInput (*decide)(void* data, const GameState* game);    // Choose the turn for the next step
+    void (*destroy)(void* data);                               // Free private data
+} Controller;
+
+// === FUNCTION PROTOTYPES ===
+
+// Returns the built-in controller with the given name, or NULL
+const Controller* FindController(const char* name);
+
+// Returns the number of built-in controllers
+int GetControllerCount(void);
+
+// Returns a built-in controller by index
+const Controller* GetController(int index);
+
+#endif // CONTROLLER_H
@@ -0,0 +1,53 @@
+#include <stdio.h>
+
+#include "controller.h"
+#include "sim.h"
+
+// === AUTOPILOT TEST ===
+// Plays autopilot games on a few board sizes and fails if any of them is
+// still running after MAX_STEPS: the bot must win or die, never circle for
+// ever. Run by ctest.
+
+// === CONSTANTS ===
+#define GAMES 100                   // Games per board (seeds 1 to GAMES)
+#define MAX_STEPS 100000            // Same cap as the batch mode
+
+static const int boards[][2] = { { 8, 8 }, { 15, 15 }, { 32, 24 } };
+
+int main(void)
+{
+    const Controller* autopilot = FindController("autopilot");
+    int failures = 0;
+    for (int b = 0; b < (int)(sizeof(boards) / sizeof(boards[0])); b++)
+    {
+        GameState game;
+        if (!InitGameState(&game, boards[b][0], boards[b][1], 1)) return 1;
+        void* data = autopilot->create(&game);
+        if (!data) return 1;
+
+        int stuck = 0;
+        long long score = 0;
+        for (unsigned int seed = 1; seed <= GAMES; seed++)
+        {
+            SeedGameState(&game, seed);
+            ResetGameState(&game);
+            autopilot->reset(data, &game, seed);
+            for (int steps = 0; steps < MAX_STEPS && !game.over; steps++)
+                GameStep(&game, autopilot->decide(data, &game));
+            if (!game.over)
+            {
+                printf("%dx%d seed %u: still running after %d steps, score %d\n",
+                    boards[b][0], boards[b][1], seed, MAX_STEPS, game.score);
+                stuck++;
+            }
+            score += game.score;
+        }
+        printf("%dx%d: %d games, %d stopped at %d steps, mean score %.1f\n",
+            boards[b][0], boards[b][1], GAMES, stuck, MAX_STEPS, (double)score / GAMES);
+        failures += stuck;
+
+        autopilot->destroy(data);
+        FreeGameState(&game);
+    }
+    return failures > 0;
+}
@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "drawlist.h"
+#include "sim.h"
+#include "board.h"
+
+// === ALLOCATE ===
+// A tile holds at most one sprite
+bool InitDrawList(DrawList* list, int columns, int rows)
+{
+    *list = (DrawList){ 0 };
+    list->capacity = columns * rows;
+    list->items = malloc(sizeof(DrawItem) * (size_t)list->capacity);
+    if (!list->items)
+    {
+        list->capacity = 0;
+        return false;
+    }
+    return true;
+}
+
+static bool ViewContains(BoardView view, Cell cell)
+{
+    return cell.x >= view.x && cell.x < view.x + view.columns &&
+           cell.y >= view.y && cell.y < view.y + view.rows;
+}
+
+// === FRUITS GROUPED BY TYPE ===
+// Pass 0 counts the fruits of each type, pass 1 writes each one in the run
+// of its type, so the front-end draws one sprite after the other
+static void AddFruitItem(DrawItem* items, int next[FRUIT_COUNT], int pass, const Fruit* fruit)
+{
+    if (pass == 0) next[fruit->type]++;
+    else items[next[fruit->type]++] = (DrawItem){ SPRITE_FRUIT + fruit->type, 0, fruit->position };
+}
+
+// Whichever is smaller is walked: the fruit pool or the tiles of the view
+static int AddFruitItems(DrawItem* items, const GameState* game, BoardView view)
+{
+    const Board* board = &game->board;
+    bool walkPool = game->fruitCount < view.columns * view.rows;
+    int next[FRUIT_COUNT] = { 0 };
+    int total = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (walkPool)
+        {
+            for (int i = 0; i < game->fruitCount; i++)
+            {
+                if (ViewContains(view, game->fruits[i].position))
+                    AddFruitItem(items, next, pass, &game->fruits[i]);
+            }
+        }
+        else
+        {
+            for (int y = view.y; y < view.y + view.rows; y++)
+            {
+                int index = y * board->columns + view.x;
+                for (int x = view.x; x < view.x + view.columns; x++, index++)
+                {
+                    if (board->cells[index] == CELL_FRUIT)
+                        AddFruitItem(items, next, pass, &game->fruits[game->fruitSlot[index]]);
+                }
+            }
+        }
+
+        // Counts become the first item of each run
+        for (int type = 0; type < FRUIT_COUNT && pass == 0; type++)
+        {
+            int count = next[type];
+            next[type] = total;
+            total += count;
+        }
+    }
+    return total;
+}
+
+// === BUILD ===
+void BuildDrawList(DrawList* list, const GameState* game, BoardView view)
+{
+    const Board* board = &game->board;
+    const Snake* snake = &game->snake;
+    DrawItem* items = list->items;
+    int count = 0;
+
+    // Clip the view to the board and to the list
+    if (view.x < 0) { view.columns += view.x; view.x = 0; }
+    if (view.y < 0) { view.rows += view.y; view.y = 0; }
+    if (view.x + view.columns > board->columns) view.columns = board->columns - view.x;
+    if (view.y + view.rows > board->rows) view.rows = board->rows - view.y;
+    if (view.columns <= 0 || view.rows <= 0)
+    {
+        list->count = 0;
+        return;
+    }
+    if (view.columns * view.rows > list->capacity) view.rows = list->capacity / view.columns;
+
+    // --- Fruits ---
+    count += AddFruitItems(items, game, view);
+
+    // --- Head ---
+    // The head already faces the direction chosen for the next move
+    Cell head = SnakeSegment(snake, 0);
+    if (ViewContains(view, head))
+        items[count++] = (DrawItem){ SPRITE_HEAD, game->nextDirection * 90, head };
+
+    // --- Body and tail ---
+    // Each segment faces the way it left its tile, towards the one in front of it
+    Cell tail = SnakeSegment(snake, snake->length - 1);
+    int headIndex = BoardIndex(board, head);
+    int tailIndex = BoardIndex(board, tail);
+    for (int y = view.y; y < view.y + view.rows; y++)
+    {
+        int index = y * board->columns + view.x;
+        for (int x = view.x; x < view.x + view.columns; x++, index++)
+        {
+            if (board->cells[index] != CELL_BODY || index == headIndex) continue;
+            SpriteId sprite = (index == tailIndex) ? SPRITE_LEGS : SPRITE_BODY; // Tail uses the legs
+            items[count++] = (DrawItem){ sprite, snake->exits[index] * 90, (Cell){ x, y } };
+        }
+    }
+
+    // --- Fences ---
+    for (int y = view.y; y < view.y + view.rows; y++)
+    {
+        const unsigned char* row = board->cells + y * board->columns;
+        for (int x = view.x; x < view.x + view.columns; x++)
+        {
+            if (row[x] == CELL_FENCE)
+                items[count++] = (DrawItem){ SPRITE_FENCE, 0, (Cell){ x, y } };
+        }
+    }
+
+    list->count = count;
+}
+
+// === FREE ===
+void FreeDrawList(DrawList* list)
+{
+    free(list->items);
+    *list = (DrawList){ 0 };
+}
+
+// === TILE CODES ===
+// A tile holds its sprite and rotation in one byte: 1 + sprite * 4 + quarter turns
+static unsigned char TileCode(const DrawItem* item)
+{
+    return (unsigned char)(1 + item->sprite * 4 + item->angle / 90);
+}
+
+static DrawItem TileItem(unsigned char code, Cell cell)
+{
+    return (DrawItem){ (SpriteId)((code - 1) / 4), (code - 1) % 4 * 90, cell };
+}
+
+// Fruits and fences keep their natural size and may reach past their tile
+static bool Oversized(unsigned char code)
+{
+    return code != 0 && (code - 1) / 4 >= SPRITE_FRUIT;
+}
+
+// Same order as BuildDrawList(): fruits by type, then the snake, then fences
+static int DrawOrder(SpriteId sprite)
+{
+    if (sprite == SPRITE_FENCE) return 2 * SPRITE_NUMBER;
+    return (sprite >= SPRITE_FRUIT) ? sprite : SPRITE_NUMBER + sprite;
+}
+
+// === ALLOCATE THE GRIDS ===
+bool InitDrawDiff(DrawDiff* diff, int columns, int rows)
+{
+    *diff = (DrawDiff){ 0 };
+    size_t tiles = (size_t)columns * (size_t)rows;
+    diff->shown = calloc(tiles, 1);
+    diff->next = calloc(tiles, 1);
+    diff->marked = calloc(tiles, 1);
+    diff->dirty = malloc(sizeof(Cell) * tiles);
+    if (!diff->shown || !diff->next || !diff->marked || !diff->dirty)
+    {
+        FreeDrawDiff(diff);
+        return false;
+    }
+    diff->columns = columns;
+    diff->rows = rows;
+    return true;
+}
+
+// Tiles past the right or bottom edge of the view are not drawn
+static void MarkDirty(DrawDiff* diff, int x, int y)
+{
+    if (x >= diff->columns || y >= diff->rows) return;
+    int index = y * diff->columns + x;
+    if (diff->marked[index]) return;
+    diff->marked[index] = 1;
+    diff->dirty[diff->dirtyCount++] = (Cell){ diff->view.x + x, diff->view.y + y };
+}
+
+// === COMPARE A LIST WITH WHAT WAS SHOWN ===
+int DiffDrawList(DrawDiff* diff, const DrawList* list, BoardView view)
+{
+    size_t tiles = (size_t)diff->columns * (size_t)diff->rows;
+    bool whole = !diff->valid || view.x != diff->view.x || view.y != diff->view.y; // The camera moved
+    diff->view = view;
+    diff->dirtyCount = 0;
+    if (tiles == 0) return -1;
+
+    memset(diff->next, 0, tiles);
+    for (int i = 0; i < list->count; i++)
+    {
+        const DrawItem* item = &list->items[i];
+        int x = item->cell.x - view.x;
+        int y = item->cell.y - view.y;
+        if (x >= 0 && y >= 0 && x < diff->columns && y < diff->rows)
+            diff->next[y * diff->columns + x] = TileCode(item);
+    }
+
+    if (!whole)
+    {
+        memset(diff->marked, 0, tiles);
+        for (int y = 0; y < diff->rows; y++)
+        {
+            int index = y * diff->columns;
+            for (int x = 0; x < diff->columns; x++, index++)
+            {
+                unsigned char before = diff->shown[index];
+                unsigned char after = diff->next[index];
+                if (before == after) continue;
+                MarkDirty(diff, x, y);
+                if (Oversized(before) || Oversized(after))
+                {
+                    MarkDirty(diff, x + 1, y);
+                    MarkDirty(diff, x, y + 1);
+                    MarkDirty(diff, x + 1, y + 1);
+                }
+            }
+        }
+    }
+
+    unsigned char* swap = diff->shown;   // The list compared is now what is shown
+    diff->shown = diff->next;
+    diff->next = swap;
+    diff->valid = true;
+    return whole ? -1 : diff->dirtyCount;
+}
+
+// === SPRITES COVERING A TILE ===
+int TileSprites(const DrawDiff* diff, Cell cell, DrawItem items[4])
+{
+    int count = 0;
+    for (int dy = -1; dy <= 0; dy++)
+    {
+        for (int dx = -1; dx <= 0; dx++)
+        {
+            int x = cell.x + dx - diff->view.x;
+            int y = cell.y + dy - diff->view.y;
+            if (x < 0 || y < 0 || x >= diff->columns || y >= diff->rows) continue;
+            unsigned char code = diff->shown[y * diff->columns + x];
+            if (code == 0 || ((dx != 0 || dy != 0) && !Oversized(code))) continue; // Nothing reaching this tile
+
+            // Insertion in drawing order
+            DrawItem item = TileItem(code, (Cell){ cell.x + dx, cell.y + dy });
+            int i = count++;
+            while (i > 0 && DrawOrder(items[i - 1].sprite) > DrawOrder(item.sprite))
+            {
+                items[i] = items[i - 1];
+                i--;
+            }
+            items[i] = item;
+        }
+    }
+    return count;
+}
+
+// === FORGET WHAT WAS SHOWN ===
+void InvalidateDrawDiff(DrawDiff* diff)
+{
+    diff->valid = false;
+}
+
+// === FREE THE GRIDS ===
+void FreeDrawDiff(DrawDiff* diff)
+{
+    free(diff->shown);
+    free(diff->next);
+    free(diff->marked);
+    free(diff->dirty);
+    *diff = (DrawDiff){ 0 };
+}
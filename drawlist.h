@@ -0,0 +1,101 @@
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include <stdbool.h>
+
+#include "sim.h"     // Game state, cells, fruit types
+
+// === HEADLESS DRAW LIST ===
+// What the board looks like, as a list of sprites on cells: built from the
+// game state without raylib, then drawn by the front-end. Keeping the two
+// apart lets the batch tools and benchmarks time the layout on its own.
+// Only the tiles of a view are looked at, so the cost follows the size of the
+// view, not the size of the board, the length of the snake or the fences.
+
+// === SPRITES IN THE ATLAS ===
+typedef enum SpriteId
+{
+    SPRITE_HEAD,                              // Snake head
+    SPRITE_BODY,                              // Snake body
+    SPRITE_LEGS,                              // Snake tail
+    SPRITE_FRUIT,                             // First fruit, followed by one per FruitType
+    SPRITE_FENCE = SPRITE_FRUIT + FRUIT_COUNT, // Fence
+    SPRITE_NUMBER                             // Number of sprites
+} SpriteId;
+
+// === ONE SPRITE TO DRAW ===
+typedef struct DrawItem
+{
+    SpriteId sprite;         // Sprite in the atlas
+    int angle;               // Clockwise rotation, multiple of 90 degrees
+    Cell cell;               // Board tile the sprite covers
+} DrawItem;
+
+// === VISIBLE PART OF THE BOARD ===
+typedef struct BoardView
+{
+    int x;                   // First visible column
+    int y;                   // First visible row
+    int columns;             // Number of visible columns
+    int rows;                // Number of visible rows
+} BoardView;
+
+// === LIST OF SPRITES IN DRAWING ORDER ===
+typedef struct DrawList
+{
+    DrawItem* items;         // Sprites, first drawn first
+    int count;               // Sprites in the list
+    int capacity;            // Sprites allocated
+} DrawList;
+
+// === TILES CHANGED SINCE THE LAST FRAME ===
+// What was drawn on each tile of the view, one byte per tile (0 = grass), so
+// two lists can be compared tile by tile: the front-end repaints only the
+// tiles whose sprite changed (the new head, the tile it left, the vacated
+// tail, an eaten or new fruit, a new fence) over a board it keeps between
+// frames. Fruits and fences drawn at their own size may cover the tiles right
+// and below theirs, so those are repainted with them.
+typedef struct DrawDiff
+{
+    unsigned char* shown;    // Sprite on each tile of the view, as last drawn
+    unsigned char* next;     // Same for the list being compared
+    unsigned char* marked;   // Tile already in dirty
+    Cell* dirty;             // Tiles to repaint, in board coordinates
+    int dirtyCount;          // Tiles in dirty
+    int columns;             // Tiles per row of the grids
+    int rows;                // Rows of the grids
+    BoardView view;          // View the shown tiles belong to
+    bool valid;              // shown matches what is on screen
+} DrawDiff;
+
+// === FUNCTION PROTOTYPES ===
+
+// Allocate a list large enough for any view of the given size
+bool InitDrawList(DrawList* list, int columns, int rows);
+
+// Fill the list with the fruits (grouped by type), the snake (head first) and the fences inside the view
+void BuildDrawList(DrawList* list, const GameState* game, BoardView view);
+
+// Free the list
+void FreeDrawList(DrawList* list);
+
+// Allocate the grids for any view of the given size, nothing shown yet
+bool InitDrawDiff(DrawDiff* diff, int columns, int rows);
+
+// Compare a list built for a view with what was shown, which it then becomes:
+// returns the number of tiles in dirty, or -1 if the whole view must be drawn
+// (nothing shown yet, or another view)
+int DiffDrawList(DrawDiff* diff, const DrawList* list, BoardView view);
+
+// Sprites covering a tile of the last list compared, in drawing order: its own
+// and those of its top-left neighbours reaching into it (two fruits of one
+// type overlapping stack in row order); returns how many
+int TileSprites(const DrawDiff* diff, Cell cell, DrawItem items[4]);
+
+// Forget what was shown: the next comparison asks for the whole view
+void InvalidateDrawDiff(DrawDiff* diff);
+
+// Free the grids
+void FreeDrawDiff(DrawDiff* diff);
+
+#endif // DRAWLIST_H
@@ -1,20 +1,60 @@
 #include <raylib.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include "game.h"
 #include "snake.h"
 #include "food.h"
 #include "ressources.h"
 #include "hint.h"
+#include "sim.h"
+#include "loader.h"
+#include "replay.h"
+#include "save.h"
+#include "trace.h"
+#include "controller.h"
+#include "audio.h"
 
 // === GLOBAL VARIABLES ===
-int score = 0;             // Current score of the player
+GameState game = { 0 };    // State of the ongoing game (snake, fruit, fences, score)
 int highScore = 0;         // Highest score achieved
 int lastScore = 0;         // Score from the last game session
 int fps = 60;              // Target frames per second
-int frameCounter = 0;      // Frame counter used for timing movements
-float moveDelay = 10.0f;   // Delay (in frames) between snake movements
 GameScreen currentScreen = TITLE; // Current game screen (title, gameplay, pause, ending)
+float tickAccumulator = 0.0f; // Real time (ms) not yet consumed by simulation ticks
+int boardColumns = 0;      // Board width in tiles (0 = as many as the window shows)
+int boardRows = 0;         // Board height in tiles (0 = as many as the window shows)
+
+// === ASSETS NEEDED BY EACH SCREEN ===
+// Screens wait behind a loading screen until these are uploaded; the rest keeps loading
+static const unsigned int screenAssets[] = {
+    [TITLE] = ASSET_FONT | ASSET_MUSIC(0),
+    [GAMEPLAY] = ASSET_FONT | ASSET_SPRITES | ASSET_SOUNDS | ASSET_MUSIC(2) | ASSET_MUSIC(3),
+    [ENDING] = ASSET_FONT | ASSET_MUSIC(4) | ASSET_MUSIC(5),
+    [PAUSE] = ASSET_FONT | ASSET_MUSIC(1)
+};
+static bool firstFrameReported = false;   // Time to the first menu frame was logged
+static bool allAssetsReported = false;    // Time to the last asset was logged
+
+// === REPLAY OF THE ONGOING GAME ===
+static unsigned int gameSeed = 0;         // Seed of the ongoing game (saved in its replay)
+static ReplayWriter replay = { 0 };       // Turns and events of the ongoing game
+
+// === FRAME TIME OVERLAY ===
+#ifdef SNAKE_TRACE
+static bool showFrameStats = false;       // F3 toggles the p50/p99/max overlay
+#endif
+
+// === AUTOPILOT ===
+static const Controller* autopilot = NULL; // Built-in AI that can play in place of the arrow keys
+static void* autopilotData = NULL;        // Its distance field, kept across ticks
+static bool autopilotOn = false;          // A toggles it during gameplay
+
+// === PLAYER TURNS ===
+static TurnQueue turnQueue;               // Arrow keys waiting for their tick
+
+// === BOARD SPRITES ===
+static DrawList boardSprites = { 0 };     // Fruit, snake and fences of the current frame
 
 // === INITIALIZE THE GAME ===
 // Set up window, audio, load resources, and initialize game entities
@@ -22,10 +62,11 @@ void InitSnakeGame(void)
 {
     InitWindow(screenWidth, screenHeight, "The Snakeman");  // Create game window
     InitAudioDevice();                                      // Initialize audio
+    StartAudioService();                                    // Music streams refilled on their own thread
     SetTargetFPS(fps);                                      // Set target FPS
 
-    LoadGameRessources();  // Load textures, audio, and fonts
-    SetGameVariables();    // Initialize game variables (score, angles, etc.)
+    LoadGameRessources();  // Start loading textures, audio, and fonts
+    SetGameVariables();    // Initialize game variables (screen, etc.)
     InitGameEntities();    // Initialize snake and fruit entities
 }
 
@@ -33,35 +74,48 @@ void InitSnakeGame(void)
 // Reset game variables at the start or after restart
 void SetGameVariables(void)
 {
-    score = 0;
     currentScreen = TITLE;
-    headAngle = 90;      // Initial snake head rotation
-    frameCounter = 0;
-    moveDelay = 10.0f;   // Initial movement delay
 }
 
 // === INITIALIZE GAME ENTITIES ===
-// Initialize snake and fruit
+// Create the game state: board, snake and fruit
 void InitGameEntities(void)
 {
-    InitializeSnake();  // Create snake
-    InitFruit();        // Initialize fruit positions
+    int viewColumns = screenWidth / tileSize;                 // Tiles per row of the window
+    int viewRows = (screenHeight - whiteHeight) / tileSize;   // Tiles under the HUD bar
+    int columns = (boardColumns > 0) ? boardColumns : viewColumns;
+    int rows = (boardRows > 0) ? boardRows : viewRows;
+    gameSeed = (unsigned int)time(NULL);                      // Different fruit and fences every launch
+    if (!InitGameState(&game, columns, rows, gameSeed))
+    {
+        TraceLog(LOG_WARNING, "GAME: Could not create a %dx%d board, using %dx%d", columns, rows, viewColumns, viewRows);
+        InitGameState(&game, viewColumns, viewRows, gameSeed);
+    }
+    if (feastFruits > 0)
+    {
+        SetFruitTarget(&game, feastFruits);   // Feast mode: refill the board with the new target
+        SeedGameState(&game, gameSeed);       // From the seed again, as the replay will
+        ResetGameState(&game);
+    }
+    InitDrawList(&boardSprites, viewColumns + 1, viewRows + 1); // Sized for the view, not the board
+    InitTurnQueue(&turnQueue);
+    autopilot = FindController("autopilot");
+    autopilotData = autopilot->create(&game);             // NULL if out of memory: no autopilot
+    BeginReplay(&replay, &game, gameSeed, REPLAY_KEYFRAME_INTERVAL);
 }
 
 // === RESET GAME ===
 // Reset snake, score, fences, and audio for a new game
 void GameReset(void)
 {
-    FreeSnake();             // Free existing snake linked list
-    head = CreateSnake();    // Create a new snake
-    direction = (Vector2){ (float)tileSize, 0.0f };
-    nextDirection = direction;
-    fruitActive = false;     // No active fruit initially
-    score = 0;               // Reset score
-    frameCounter = 0;
-    moveDelay = 10.0f;
-
-    fenceCount = 0;          // Reset fence count
+    gameSeed = gameSeed * 1664525u + 1013904223u; // Next seed: each game replays from its own
+    SeedGameState(&game, gameSeed);
+    ResetGameState(&game);   // New snake, no fruit, no fences, score 0
+    BeginReplay(&replay, &game, gameSeed, REPLAY_KEYFRAME_INTERVAL);
+    if (autopilotData) autopilot->reset(autopilotData, &game, gameSeed);
+    InitTurnQueue(&turnQueue); // No turn of the last game, latency measured afresh
+    tickAccumulator = 0.0f;  // Next game starts with a full tick interval
+    InvalidateBoardLayer();  // New snake, fruits and fences everywhere
 
     // Reset audio flags to start music appropriately
     firstFrameTitle = true;
@@ -70,17 +124,44 @@ void GameReset(void)
     playMusicEnding = -1;
 }
 
+// === QUICK-LOAD ===
+// Replaces the ongoing game with the quick-save; its replay is dropped since
+// the loaded game no longer follows from the seed
+static void QuickLoad(void)
+{
+    int columns = game.board.columns;
+    int rows = game.board.rows;
+    if (!LoadGameState(&game, SAVE_FILE))
+    {
+        TraceLog(LOG_WARNING, "SAVE: Could not load %s", SAVE_FILE);
+        return;
+    }
+    if (autopilotData && (game.board.columns != columns || game.board.rows != rows))
+    {
+        autopilot->destroy(autopilotData);      // Its distance field has the old size
+        autopilotData = autopilot->create(&game);
+        autopilotOn = autopilotOn && autopilotData;
+    }
+    if (autopilotData) autopilot->reset(autopilotData, &game, gameSeed);
+    StopReplay(&replay);      // Nothing more is recorded, and nothing saved at the end
+    ClearTurnQueue(&turnQueue); // Turns pressed for the state that was left
+    tickAccumulator = 0.0f;
+    InvalidateBoardLayer();     // Nothing of the board shown is left
+    TraceLog(LOG_INFO, "SAVE: Loaded %s at tick %d", SAVE_FILE, game.tickCounter);
+}
+
 // === UPDATE TITLE SCREEN ===
 void UpdateTitleScreen(void)
 {
+    TRACE_BEGIN("audio");
     PlayTitleAudio();  // Play background music for title screen
+    TRACE_END();
 
     BeginDrawing();
-    ClearBackground(RAYWHITE);
-    DrawGreenTiles(screenHeight, screenWidth, tileSize, lightGreen, darkGreen); // Draw grass tiles
-    DrawRectangle(0, 0, screenWidth, screenHeight, semiTransparentBlack);       // Overlay for title
-    DrawTitleText();   // Draw "Press ENTER" text
-    EndDrawing();
+    TRACE_BEGIN("draw_text");
+    DrawTitleText();   // Overlay and "Press ENTER" text, one cached texture
+    TRACE_END();
+    PresentFrame();
 
     // Switch to gameplay when Enter is pressed
     if (IsKeyPressed(KEY_ENTER))
@@ -90,25 +171,82 @@ void UpdateTitleScreen(void)
 // === UPDATE GAMEPLAY SCREEN ===
 void UpdateGameplayScreen(void)
 {
-    frameCounter++;          // Increment frame counter
+    TRACE_BEGIN("audio");
     PlayGameplayAudio();     // Play gameplay music
-    SnakeDirectionInput();   // Handle player input
-    SnakeMovement();         // Move snake
-    FruitSpawn(head);        // Spawn a fruit if none is active
-    FruitColision();         // Check for collisions with fruit
-    SelfColision();          // Check for collisions with snake itself
-    BorderColision();        // Check for collisions with borders
-    FenceColision();        // Check for collisions with fences
+    TRACE_END();
+
+    // Turns are queued as they are pressed, each tick takes one
+    TRACE_BEGIN("input");
+    if (IsKeyPressed(KEY_A) && autopilotData)
+    {
+        autopilotOn = !autopilotOn;   // Hand the snake to the autopilot, or take it back
+        ClearTurnQueue(&turnQueue);
+    }
+    if (!autopilotOn)
+        SnakeDirectionInput(&turnQueue);
+    if (IsKeyPressed(KEY_F5))
+        TraceLog(SaveGameState(&game, SAVE_FILE) ? LOG_INFO : LOG_WARNING, "SAVE: Quick-save to %s", SAVE_FILE);
+    if (IsKeyPressed(KEY_F9))
+        QuickLoad();
+    TRACE_END();
+
+    // Run as many ticks as the real time elapsed since the last frame allows
+    float elapsed = GetFrameTime() * 1000.0f;
+    if (elapsed > MAX_FRAME_TIME) elapsed = MAX_FRAME_TIME; // Don't race to catch up after a stall
+    tickAccumulator += elapsed;
+
+    TRACE_BEGIN("simulation");
+    unsigned int events = EVENT_NONE;
+    int ticks = 0;
+    while (tickAccumulator >= game.tickInterval && !game.over)
+    {
+        tickAccumulator -= game.tickInterval;
+        ticks++;
+        if (autopilotOn)
+            ApplyGameInput(&game, autopilot->decide(autopilotData, &game)); // Decides on every tick
+        else
+            ApplyGameInput(&game, PopTurn(&turnQueue, &game, GetTime() * 1000.0)); // Oldest turn it can take
+        RecordReplayTurn(&replay, &game);  // Only ticks that change direction take space
+        unsigned int stepEvents = GameStep(&game, (GameInput){ DIRECTION_NONE }); // Move and check collisions
+        RecordReplayTick(&replay, &game, stepEvents);
+        events |= stepEvents;
+    }
+    TRACE_END();
+
+    if (events & EVENT_ATE_FRUIT)
+        PlaySound(game.lastEaten == NORMAL_FRUIT ? gameSound[0] : gameSound[1]); // Eating sound
+    if (events & (EVENT_DIED | EVENT_WON))
+    {
+        currentScreen = ENDING;  // Snake crashed or the board is full
+        bool recorded = replay.recording;  // Not after a quick-load
+        if (recorded && (!FinishReplay(&replay, &game) || !SaveReplay(&replay, REPLAY_FILE)))
+            TraceLog(LOG_WARNING, "REPLAY: Could not save %s", REPLAY_FILE);
+        if (turnQueue.taken > 0)
+            TraceLog(LOG_INFO, "INPUT: %d turns, key to tick %.1f ms mean, %.1f ms max, %u dropped (queue full)",
+                turnQueue.taken, turnQueue.latencyTotal / turnQueue.taken, turnQueue.latencyMax,
+                atomic_load(&turnQueue.overflows));
+    }
 
     // --- DRAW GAMEPLAY ---
+    // The board only changes on a tick: between two, the retained one is shown as it is
+    if (ticks > 0 || BoardLayerStale())
+    {
+        UpdateBoardCamera(&game);  // Follow the head before anything is drawn
+        TRACE_BEGIN("draw_list");
+        BuildDrawList(&boardSprites, &game, GetBoardView()); // Visible fruit, snake and fences, without raylib
+        TRACE_END();
+        TRACE_BEGIN("draw_board");
+        UpdateBoardLayer(&boardSprites, GetBoardView());     // Repaint the tiles that changed
+        TRACE_END();
+    }
     BeginDrawing();
-    ClearBackground(RAYWHITE);
-    DrawGreenTiles(screenHeight, screenWidth, tileSize, lightGreen, darkGreen); // background
-    DrawGameplayText();   // Draw score, high score, last score
-    DrawFruit();          // Draw fruit
-    DrawSnake();          // Draw snake
-    DrawFences();          // Draw fences
-    EndDrawing();
+    TRACE_BEGIN("draw_text");
+    DrawGameplayText();   // HUD bar with the scores, redrawn only when they change
+    TRACE_END();
+    TRACE_BEGIN("draw_background");
+    DrawBoardLayer();     // Grass, fruit, snake and fences in one quad
+    TRACE_END();
+    PresentFrame();
 
     // Pause the game if 'P' is pressed
     if (IsKeyPressed(KEY_P))
@@ -118,21 +256,20 @@ void UpdateGameplayScreen(void)
 // === UPDATE PAUSE SCREEN ===
 void UpdatePauseScreen(void)
 {
+    TRACE_BEGIN("audio");
     PlayPauseAudio();  // Play pause screen music
+    TRACE_END();
 
     BeginDrawing();
-    ClearBackground(RAYWHITE);
-    DrawGreenTiles(screenHeight, screenWidth, tileSize, lightGreen, darkGreen);
-    DrawRectangle(0, 0, screenWidth, screenHeight, semiTransparentBlack); // overlay
-    DrawPauseText();    // Draw pause text
-    EndDrawing();
+    TRACE_BEGIN("draw_text");
+    DrawPauseText();    // Overlay and pause text, one cached texture
+    TRACE_END();
+    PresentFrame();
 
     // Resume gameplay if Enter is pressed
     if (IsKeyPressed(KEY_ENTER))
     {
-        StopMusicStream(gameMusic[playMusicPause]);
-        playMusicPause = -1;
-        ResumeMusicStream(gameMusic[playMusicGameplay]);
+        ResumeGameplayAudio();
         currentScreen = GAMEPLAY;
     }
 }
@@ -140,18 +277,19 @@ void UpdatePauseScreen(void)
 // === UPDATE ENDING SCREEN ===
 void UpdateEndingScreen(void)
 {
-    lastScore = score;        // Store last score
-    if (score > highScore)
-        highScore = score;    // Update high score
+    lastScore = game.score;   // Store last score
+    if (game.score > highScore)
+        highScore = game.score; // Update high score
 
+    TRACE_BEGIN("audio");
     PlayEndingAudio();        // Play ending music
+    TRACE_END();
 
     BeginDrawing();
-    ClearBackground(RAYWHITE);
-    DrawGreenTiles(screenHeight, screenWidth, tileSize, lightGreen, darkGreen);
-    DrawRectangle(0, 0, screenWidth, screenHeight, semiTransparentBlack); // overlay
-    DrawEndingText();  // Show game over text
-    EndDrawing();
+    TRACE_BEGIN("draw_text");
+    DrawEndingText();  // Overlay and game over text, one cached texture
+    TRACE_END();
+    PresentFrame();
 
     // Restart game if Enter is pressed
     if (IsKeyPressed(KEY_ENTER))
@@ -161,9 +299,83 @@ void UpdateEndingScreen(void)
     }
 }
 
+// === DRAW LOADING SCREEN ===
+// Shown while the assets of the current screen are still being decoded
+void DrawLoadingScreen(void)
+{
+    BeginDrawing();
+    DrawOverlayBackground(); // Backgrounds need no files, they are ready at once
+    DrawText("Loading...", screenWidth / 2 - MeasureText("Loading...", 40) / 2, screenHeight / 2 - 20, 40, WHITE);
+    PresentFrame();
+}
+
+// === DRAW FRAME TIME OVERLAY ===
+// p50/p99/max of the last frames, top right of the HUD bar
+void DrawFrameStats(void)
+{
+#ifdef SNAKE_TRACE
+    FrameStats stats;
+    if (!showFrameStats || !GetFrameStats(&stats)) return;
+
+    const char* text = TextFormat("p50 %.1f  p99 %.1f  max %.1f ms", stats.p50, stats.p99, stats.max);
+    int width = MeasureText(text, 20);
+    DrawRectangle(screenWidth - width - 20, 4, width + 16, 28, semiTransparentBlack);
+    DrawText(text, screenWidth - width - 12, 8, 20, (stats.p99 > 1000.0f / fps * 1.5f) ? RED : WHITE); // Red when frames are missed
+#endif
+}
+
+// === PRESENT THE FRAME ===
+// Ends drawing for every screen; the swap (and the vsync wait) gets its own zone
+void PresentFrame(void)
+{
+    DrawFrameStats();
+    TRACE_BEGIN("present");
+    EndDrawing();
+    TRACE_END();
+}
+
+// === REPORT STARTUP TIMES ===
+// Seconds since the window opened, once for the first real frame and once for the last asset
+static void ReportStartup(void)
+{
+    if (!firstFrameReported)
+    {
+        TraceLog(LOG_INFO, "STARTUP: first frame after %.3f s", GetTime());
+        firstFrameReported = true;
+    }
+    if (!allAssetsReported && AssetsReady(ASSET_ALL))
+    {
+        TraceLog(LOG_INFO, "STARTUP: every asset loaded after %.3f s", GetTime());
+        allAssetsReported = true;
+    }
+}
+
 // === UPDATE GAME BASED ON CURRENT SCREEN ===
 void UpdateGame(void)
 {
+    TRACE_FRAME();          // Frame time statistics
+    TRACE_BEGIN("frame");
+    if (IsWindowResized())
+        LoadBackgrounds();  // Cached backgrounds follow the window
+
+#ifdef SNAKE_TRACE
+    if (IsKeyPressed(KEY_F3))
+        showFrameStats = !showFrameStats;
+    if (IsKeyPressed(KEY_F4))
+        TraceLog(ExportTrace(TRACE_FILE) ? LOG_INFO : LOG_WARNING, "TRACE: Export to %s", TRACE_FILE);
+#endif
+
+    TRACE_BEGIN("loader");
+    UpdateAssetLoading();   // Upload whatever the loader threads finished
+    TRACE_END();
+    if (!AssetsReady(screenAssets[currentScreen]))
+    {
+        DrawLoadingScreen();
+        TRACE_END();
+        return;
+    }
+    ReportStartup();
+
     switch (currentScreen)
     {
     case TITLE:
@@ -181,26 +393,30 @@ void UpdateGame(void)
     default:
         break;
     }
+    TRACE_END();
 }
 
 // === UNLOAD ALL TEXTURES ===
 void UnloadGameTextures(void)
 {
-    UnloadTexture(headTexture);
-    UnloadTexture(bodyTexture);
-    UnloadTexture(legsTexture);
-
-    for (int i = 0; i < FRUIT_NUMBER; i++)
-        UnloadTexture(fruitTextures[i]);
-
-    UnloadTexture(fenceTexture);
-    UnloadFont(myFont);
+    UnloadTexture(spriteAtlas);  // Every sprite is in the atlas
+    for (int i = 0; i < FONT_SIZE_COUNT; i++)
+        UnloadFont(fonts[i]);    // The default font, if it stood in, is left alone
+    UnloadBackgrounds();
 }
 
 // === FREE ALL RESOURCES ===
 void FreeSnakeGame(void)
 {
-    FreeSnake();         // Free linked list of snake
+    StopAssetLoading();   // Join the loader threads (the game may close while loading)
+    FreeGameState(&game); // Free snake buffer and occupancy grid
+    FreeDrawList(&boardSprites);
+    if (autopilotData) autopilot->destroy(autopilotData);
     UnloadGameTextures(); // Free textures and font
     FreeMusic();          // Free music and sounds
+    FreeAssetData();      // Free the music files the streams were reading
+    FreeReplayWriter(&replay);
+#ifdef SNAKE_TRACE
+    ShutdownTrace();      // Loader threads are joined: no one traces anymore
+#endif
 }
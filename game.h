@@ -8,6 +8,10 @@
 #include "snake.h"      // Access to snake structures and functions
 #include "food.h"       // Access to fruit structures and functions
 #include "hint.h"       // Access to hint functions
+#include "sim.h"        // Access to the headless game rules
+
+// === CONSTANTS ===
+#define MAX_FRAME_TIME 250.0f   // Longest frame (ms) the simulation clock catches up on
 
 // === GAME STATES ===
 // Enum representing the different game screens / states
@@ -21,17 +25,18 @@ typedef enum GameScreen
 
 // === GLOBAL VARIABLES ===
 
-// Frame counter used for timing and animations
-extern int frameCounter;
-
-// Delay between snake movements (controls speed)
-extern float moveDelay;
+// State of the ongoing game (snake, fruit, fences, score, speed)
+extern GameState game;
 
-// Frames per second of the game
+// Frames per second of the game (rendering only, the game speed is in game.tickInterval)
 extern int fps;
 
-// Current score in the ongoing game
-extern int score;
+// Real time (ms) not yet consumed by simulation ticks
+extern float tickAccumulator;
+
+// Board size in tiles, set before InitSnakeGame() (0 = as many as the window shows)
+extern int boardColumns;
+extern int boardRows;
 
 // Highest score recorded
 extern int highScore;
@@ -50,13 +55,13 @@ void SetGameVariables(void);
 // Initialize the entire game (window, state, etc.)
 void InitSnakeGame(void);
 
-// Initialize all game entities (snake, fruits, fences, etc.)
+// Initialize the game state (board, snake, fruits, fences, etc.)
 void InitGameEntities(void);
 
 // Update the title screen (animations, keyboard input, etc.)
 void UpdateTitleScreen(void);
 
-// Update the gameplay screen (snake movement, collisions, scoring)
+// Update the gameplay screen (input, due simulation ticks, sounds, drawing)
 void UpdateGameplayScreen(void);
 
 // Update the pause screen (display, keyboard input)
@@ -65,10 +70,19 @@ void UpdatePauseScreen(void);
 // Update the ending screen (display final score, restart/quit options)
 void UpdateEndingScreen(void);
 
+// Draw the loading screen while the current screen's assets are not ready
+void DrawLoadingScreen(void);
+
+// Draw the p50/p99/max frame time overlay when enabled (F3, tracing builds only)
+void DrawFrameStats(void);
+
+// Draw the overlays and end the frame
+void PresentFrame(void);
+
 // Update the game based on the current screen/state (called in main loop)
 void UpdateGame(void);
 
-// Load all game resources (textures, music, sounds)
+// Start loading all game resources (textures, music, sounds)
 void LoadGameRessources(void);
 
 // Unload all textures to free memory
@@ -2,22 +2,14 @@
 
 #include <raylib.h>
 
-// === Forward declaration of the snake ===
-struct Segment;
-extern struct Segment* head;
+// === Forward declaration of the game state ===
+struct GameState;
+extern struct GameState game;
 
 // === Global game variables ===
-extern int score;
 extern int highScore;
 extern int lastScore;
-extern int frameCounter;
-extern float moveDelay;
 extern int fps;
-extern int headAngle;
-
-// === Snake direction variables ===
-extern Vector2 direction;
-extern Vector2 nextDirection;
 
 // === Screen and grid size ===
 extern const int screenWidth;
@@ -26,15 +18,8 @@ extern const int tileSize;
 extern const int whiteHeight;
 
 // === Textures and font ===
-extern Texture2D headTexture;
-extern Texture2D bodyTexture;
-extern Texture2D legsTexture;
-extern Texture2D fruitTexture;
-extern Texture2D fruitTextures[5]; // FRUIT_NUMBER
-extern Texture2D fenceTexture;
-extern Font myFont;
-extern Vector2 origin;
-extern Rectangle sourceRec;
+extern Texture2D spriteAtlas;
+extern Font fonts[5];
 
 // === Colors ===
 extern Color lightGreen;
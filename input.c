@@ -0,0 +1,61 @@
+#include "input.h"
+
+// === INITIALIZE QUEUE ===
+void InitTurnQueue(TurnQueue* queue)
+{
+    atomic_init(&queue->head, 0u);
+    atomic_init(&queue->tail, 0u);
+    atomic_init(&queue->overflows, 0u);
+    queue->taken = 0;
+    queue->latencyTotal = 0.0;
+    queue->latencyMax = 0.0;
+}
+
+// === ADD A TURN (PRODUCER) ===
+// The entry is written before tail is published, so the consumer never reads it half done
+bool PushTurn(TurnQueue* queue, Direction turn, double time)
+{
+    unsigned int tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (tail - head >= TURN_QUEUE_SIZE)
+    {
+        atomic_fetch_add_explicit(&queue->overflows, 1u, memory_order_relaxed);
+        return false;   // The oldest turns are kept: they were pressed first
+    }
+    queue->turns[tail % TURN_QUEUE_SIZE] = (QueuedTurn){ turn, time };
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+// === TAKE THE TURN OF A TICK (CONSUMER) ===
+// Same rule as ApplyGameInput(): only a perpendicular turn changes anything
+GameInput PopTurn(TurnQueue* queue, const GameState* game, double now)
+{
+    unsigned int head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    bool horizontal = (game->direction == DIRECTION_LEFT || game->direction == DIRECTION_RIGHT);
+
+    GameInput input = { DIRECTION_NONE };
+    while (head != tail && input.turn == DIRECTION_NONE)
+    {
+        QueuedTurn queued = queue->turns[head % TURN_QUEUE_SIZE];
+        head++;
+        bool turnHorizontal = (queued.turn == DIRECTION_LEFT || queued.turn == DIRECTION_RIGHT);
+        if (horizontal == turnHorizontal) continue;   // Refused now: try the next one on this tick
+
+        input.turn = queued.turn;
+        double latency = now - queued.time;
+        queue->taken++;
+        queue->latencyTotal += latency;
+        if (latency > queue->latencyMax) queue->latencyMax = latency;
+    }
+    atomic_store_explicit(&queue->head, head, memory_order_release);
+    return input;
+}
+
+// === DROP THE QUEUED TURNS (CONSUMER) ===
+void ClearTurnQueue(TurnQueue* queue)
+{
+    unsigned int tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    atomic_store_explicit(&queue->head, tail, memory_order_release);
+}
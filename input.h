@@ -0,0 +1,59 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include "sim.h"     // Directions and turns
+
+// === QUEUE OF PLAYER TURNS ===
+// Every arrow key pressed is pushed with the time it was read, in the order it
+// was pressed, and each tick takes at most one turn from the front. Two turns
+// pressed within one tick (a quick U-turn: up then left while going right)
+// are played on two ticks instead of the second one being refused.
+//
+// The queue is a single-producer single-consumer ring: the producer only
+// writes tail and the consumer only writes head, so the side reading the keys
+// and the side stepping the game never wait on each other, on one thread or two.
+// Turns the snake could not take when they come up (the same axis as its
+// direction) are dropped at that point, so a refused key never costs a tick.
+
+// === CONSTANTS ===
+#define TURN_QUEUE_SIZE 4            // Turns buffered ahead of the snake (power of two)
+
+// === ONE TURN ===
+typedef struct QueuedTurn
+{
+    Direction turn;          // Requested direction
+    double time;             // When the key was read (ms)
+} QueuedTurn;
+
+// === TURN QUEUE ===
+typedef struct TurnQueue
+{
+    QueuedTurn turns[TURN_QUEUE_SIZE];
+    atomic_uint head;        // Next turn to take (written by the consumer)
+    atomic_uint tail;        // Next free entry (written by the producer)
+    atomic_uint overflows;   // Turns dropped because the queue was full
+
+    // Consumer side: time from key to tick of the turns taken
+    int taken;               // Turns given to the game
+    double latencyTotal;     // Sum of their latencies (ms)
+    double latencyMax;       // Longest latency (ms)
+} TurnQueue;
+
+// === FUNCTION PROTOTYPES ===
+
+// Empty queue, statistics cleared
+void InitTurnQueue(TurnQueue* queue);
+
+// Producer: add a turn read at the given time (ms); returns false if the queue is full
+bool PushTurn(TurnQueue* queue, Direction turn, double time);
+
+// Consumer: the turn for the next tick of a game (DIRECTION_NONE if none), taken at now (ms)
+GameInput PopTurn(TurnQueue* queue, const GameState* game, double now);
+
+// Consumer: drop the queued turns (new game, autopilot, loaded state)
+void ClearTurnQueue(TurnQueue* queue);
+
+#endif // INPUT_H
@@ -0,0 +1,554 @@
+#include <raylib.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+#include "loader.h"
+#include "pack.h"
+#include "trace.h"
+#include "ressources.h"
+#include "audio.h"
+
+// === CONSTANTS ===
+#define MAX_LOAD_JOBS 32       // Room for every asset file plus the atlas
+#define FONT_GLYPHS 95         // Printable ASCII characters
+#define FONT_PADDING 4         // Same padding LoadFont() uses
+
+// === KINDS OF JOBS ===
+typedef enum JobKind
+{
+    JOB_FONT,      // TTF file -> glyph atlas image at one size of fontSizes
+    JOB_SPRITE,    // PNG file -> white keyed out, four rotations
+    JOB_ATLAS,     // Every sprite -> one atlas image (run by the last sprite job)
+    JOB_SOUND,     // WAV file -> decoded wave
+    JOB_MUSIC      // MP3 file -> bytes kept in memory for streaming
+} JobKind;
+
+// === ONE FILE TO LOAD ===
+// Workers fill the results and then set done; the main thread only reads
+// them after seeing done, uploads them and sets uploaded
+typedef struct LoadJob
+{
+    JobKind kind;
+    int index;                   // Font size, sprite, sound or music index
+    const char* file;            // File to read
+    unsigned int asset;          // ASSET_* flag the job contributes to
+
+    Image variants[4];           // JOB_SPRITE: image at 0/90/180/270 degrees
+    Image image;                 // JOB_FONT, JOB_ATLAS: image to upload
+    GlyphInfo* glyphs;           // JOB_FONT: glyph metrics and bitmaps
+    Rectangle* recs;             // JOB_FONT: glyph areas in the image
+    Wave wave;                   // JOB_SOUND: decoded samples
+    unsigned char* data;         // JOB_MUSIC: encoded file
+    int dataSize;                // JOB_MUSIC: size of the encoded file
+
+    bool borrowed;               // image, wave and data point into the asset pack
+
+    atomic_bool done;            // Set by the worker when the results are ready
+    bool uploaded;               // Set by the main thread once the asset is usable
+} LoadJob;
+
+// === LOADER STATE ===
+static LoadJob jobs[MAX_LOAD_JOBS];   // Jobs in priority order, atlas last
+static int jobCount = 0;              // Number of jobs, atlas included
+static int queuedJobCount = 0;        // Jobs taken by workers (all but the atlas)
+static atomic_int nextJob;            // Next job a worker will take
+static atomic_int spritesLeft;        // Sprite jobs not finished yet
+static atomic_bool cancelLoading;     // Stop taking jobs (closing while loading)
+static thrd_t workers[LOADER_THREADS];
+static bool workerStarted[LOADER_THREADS];
+static LoadJob* atlasJob = NULL;      // Job holding the composed atlas
+static int firstSpriteJob = 0;        // Sprite i is jobs[firstSpriteJob + i]
+static AssetPack assetPack = { 0 };   // Mapped pack, if there is one
+
+// === FILES TO LOAD ===
+static const char* spriteFiles[SPRITE_NUMBER] = {
+    "Assets/head.png",          // SPRITE_HEAD
+    "Assets/body.png",          // SPRITE_BODY
+    "Assets/legs.png",          // SPRITE_LEGS
+    "Assets/fruit.png",         // SPRITE_FRUIT + NORMAL_FRUIT
+    "Assets/red_fruit.png",     // SPRITE_FRUIT + RED_FRUIT
+    "Assets/blue_fruit.png",    // SPRITE_FRUIT + BLUE_FRUIT
+    "Assets/orange_fruit.png",  // SPRITE_FRUIT + ORANGE_FRUIT
+    "Assets/purple_fruit.png",  // SPRITE_FRUIT + PURPLE_FRUIT
+    "Assets/fence.png"          // SPRITE_FENCE
+};
+
+static const char* musicFiles[MUSIC_NUMBER] = {
+    "Assets/Tic_Tac.mp3",                  // Title screen
+    "Assets/pause_music.mp3",              // Pause screen
+    "Assets/Hard_Rock.mp3",                // Gameplay track 1
+    "Assets/Jay_in_the_elevator.mp3",      // Gameplay track 2
+    "Assets/bs_loosing_theme.mp3",         // Ending track 1
+    "Assets/bs_loosing_theme_slowed.mp3"   // Ending track 2
+};
+
+static const char* soundFiles[SOUND_NUMBER] = {
+    "Assets/eating_sound.wav",             // Normal eating sound
+    "Assets/eating_bonus_sound.wav"        // Bonus eating sound
+};
+
+static void AddJob(JobKind kind, int index, const char* file, unsigned int asset)
+{
+    LoadJob* job = &jobs[jobCount++];
+    *job = (LoadJob){ 0 };
+    job->kind = kind;
+    job->index = index;
+    job->file = file;
+    job->asset = asset;
+    atomic_init(&job->done, false);
+}
+
+// === BUILD THE SPRITE ATLAS ===
+// One row per sprite with its four clockwise rotations side by side
+static void BuildAtlas(void)
+{
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    for (int i = 0; i < SPRITE_NUMBER; i++)
+    {
+        LoadJob* sprite = &jobs[firstSpriteJob + i];
+        int rowWidth = 0;
+        int rowHeight = 0;
+        for (int r = 0; r < 4; r++)
+        {
+            spriteRects[i][r] = (Rectangle){ (float)rowWidth, (float)atlasHeight,
+                (float)sprite->variants[r].width, (float)sprite->variants[r].height };
+            rowWidth += sprite->variants[r].width + ATLAS_PADDING;  // Gap avoids bleeding when filtering
+            if (sprite->variants[r].height > rowHeight) rowHeight = sprite->variants[r].height;
+        }
+        if (rowWidth > atlasWidth) atlasWidth = rowWidth;
+        atlasHeight += rowHeight + ATLAS_PADDING;
+    }
+
+    // Copy every variant to its place in the atlas
+    atlasJob->image = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    for (int i = 0; i < SPRITE_NUMBER; i++)
+    {
+        LoadJob* sprite = &jobs[firstSpriteJob + i];
+        for (int r = 0; r < 4; r++)
+        {
+            Rectangle source = { 0, 0, (float)sprite->variants[r].width, (float)sprite->variants[r].height };
+            ImageDraw(&atlasJob->image, sprite->variants[r], source, spriteRects[i][r], WHITE);
+            UnloadImage(sprite->variants[r]);
+            sprite->variants[r] = (Image){ 0 };
+        }
+    }
+    atomic_store(&atlasJob->done, true);
+}
+
+// === DECODE ONE FILE (WORKER THREAD) ===
+// Only CPU work here: raylib GPU and audio-device calls stay on the main thread
+static void RunJob(LoadJob* job)
+{
+    static const char* zoneNames[] = { "load_font", "load_sprite", "load_atlas", "load_sound", "load_music" };
+    TRACE_BEGIN(zoneNames[job->kind]);
+    switch (job->kind)
+    {
+    case JOB_FONT:
+    {
+        int size = 0;
+        unsigned char* data = LoadFileData(job->file, &size);
+        if (data)
+        {
+            int fontSize = fontSizes[job->index];   // Rasterized at the size it is drawn at
+            job->glyphs = LoadFontData(data, size, fontSize, NULL, FONT_GLYPHS, FONT_DEFAULT);
+            if (job->glyphs)
+                job->image = GenImageFontAtlas(job->glyphs, &job->recs, FONT_GLYPHS, fontSize, FONT_PADDING, 0);
+            UnloadFileData(data);
+        }
+    }
+    break;
+    case JOB_SPRITE:
+    {
+        Image image = LoadImage(job->file);                      // Decode the PNG
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);  // Same format for every piece of the atlas
+        ImageColorReplace(&image, WHITE, BLANK);                 // Replace white with transparency
+        for (int r = 0; r < 4; r++)
+        {
+            job->variants[r] = ImageCopy(image);
+            for (int turn = 0; turn < r; turn++)
+                ImageRotateCW(&job->variants[r]);                // r quarter turns clockwise
+        }
+        UnloadImage(image);
+    }
+    break;
+    case JOB_SOUND:
+        job->wave = LoadWave(job->file);
+        break;
+    case JOB_MUSIC:
+        job->data = LoadFileData(job->file, &job->dataSize);
+        break;
+    default:
+        break;
+    }
+    TRACE_END();
+    atomic_store(&job->done, true);
+
+    // The last sprite to finish packs the atlas
+    if (job->kind == JOB_SPRITE && atomic_fetch_sub(&spritesLeft, 1) == 1)
+    {
+        TRACE_BEGIN("load_atlas");
+        BuildAtlas();
+        TRACE_END();
+    }
+}
+
+// === WORKER THREAD ===
+static int LoaderMain(void* argument)
+{
+    (void)argument;
+    while (!atomic_load(&cancelLoading))
+    {
+        int index = atomic_fetch_add(&nextJob, 1);
+        if (index >= queuedJobCount) break; // Nothing left
+        RunJob(&jobs[index]);
+    }
+    return 0;
+}
+
+// === QUEUE EVERY ASSET ===
+// Jobs are queued in the order the screens need them: title first.
+// With a pack the atlas comes ready-made, so no sprite is queued.
+static void QueueJobs(bool withSprites)
+{
+    jobCount = 0;
+    for (int i = 0; i < FONT_SIZE_COUNT; i++)
+        AddJob(JOB_FONT, i, "Assets/stickman.ttf", ASSET_FONT);
+    AddJob(JOB_MUSIC, 0, musicFiles[0], ASSET_MUSIC(0));
+    AddJob(JOB_SOUND, 0, soundFiles[0], ASSET_SOUNDS);
+    AddJob(JOB_SOUND, 1, soundFiles[1], ASSET_SOUNDS);
+    AddJob(JOB_MUSIC, 2, musicFiles[2], ASSET_MUSIC(2));
+    AddJob(JOB_MUSIC, 3, musicFiles[3], ASSET_MUSIC(3));
+    AddJob(JOB_MUSIC, 1, musicFiles[1], ASSET_MUSIC(1));
+    AddJob(JOB_MUSIC, 4, musicFiles[4], ASSET_MUSIC(4));
+    AddJob(JOB_MUSIC, 5, musicFiles[5], ASSET_MUSIC(5));
+    firstSpriteJob = jobCount;
+    for (int i = 0; withSprites && i < SPRITE_NUMBER; i++)
+        AddJob(JOB_SPRITE, i, spriteFiles[i], ASSET_SPRITES);
+    queuedJobCount = jobCount;
+    AddJob(JOB_ATLAS, 0, NULL, ASSET_SPRITES);    // Filled by the last sprite job
+    atlasJob = &jobs[jobCount - 1];
+}
+
+// === START THE WORKER THREADS ===
+static void StartWorkers(void)
+{
+    atomic_store(&nextJob, 0);
+    atomic_store(&spritesLeft, SPRITE_NUMBER);
+    atomic_store(&cancelLoading, false);
+
+    for (int i = 0; i < LOADER_THREADS; i++)
+        workerStarted[i] = (thrd_create(&workers[i], LoaderMain, NULL) == thrd_success);
+
+    if (!workerStarted[0])
+        LoaderMain(NULL); // No thread available: load everything now
+}
+
+// === JOIN THE WORKER THREADS ===
+static void JoinWorkers(void)
+{
+    for (int i = 0; i < LOADER_THREADS; i++)
+    {
+        if (workerStarted[i])
+            thrd_join(workers[i], NULL);
+        workerStarted[i] = false;
+    }
+}
+
+// === IMAGE STORED IN THE PACK ===
+// The pixels stay in the mapping: nothing is decoded or copied
+static bool PackImage(const char* name, Image* image)
+{
+    const PackEntry* entry = FindPackEntry(&assetPack, name, PACK_IMAGE);
+    if (entry == NULL) return false;
+    *image = (Image){ (void*)PackEntryData(&assetPack, entry),
+        entry->params[0], entry->params[1], entry->params[3], entry->params[2] };
+    return entry->size == (uint32_t)GetPixelDataSize(image->width, image->height, image->format);
+}
+
+// === FILL ONE JOB FROM THE PACK ===
+static bool RunPackJob(LoadJob* job)
+{
+    char name[PACK_NAME_LENGTH];
+    const PackEntry* entry = NULL;
+    job->borrowed = true;
+
+    switch (job->kind)
+    {
+    case JOB_FONT:
+    {
+        snprintf(name, sizeof(name), "font%d", fontSizes[job->index]);
+        entry = FindPackEntry(&assetPack, name, PACK_GLYPHS);
+        if (entry == NULL || entry->params[0] != FONT_GLYPHS || entry->params[1] != fontSizes[job->index] ||
+            entry->size != FONT_GLYPHS * (sizeof(PackGlyph) + sizeof(Rectangle)))
+            return false;
+        snprintf(name, sizeof(name), "font_atlas%d", fontSizes[job->index]);
+        if (!PackImage(name, &job->image)) return false;
+
+        // Glyph metrics are copied: UnloadFont() frees them like any loaded font
+        const PackGlyph* glyphs = PackEntryData(&assetPack, entry);
+        job->glyphs = MemAlloc(FONT_GLYPHS * sizeof(GlyphInfo));
+        job->recs = MemAlloc(FONT_GLYPHS * sizeof(Rectangle));
+        for (int g = 0; g < FONT_GLYPHS; g++)
+            job->glyphs[g] = (GlyphInfo){ glyphs[g].value, glyphs[g].offsetX, glyphs[g].offsetY, glyphs[g].advanceX, { 0 } };
+        memcpy(job->recs, glyphs + FONT_GLYPHS, FONT_GLYPHS * sizeof(Rectangle));
+    }
+    break;
+    case JOB_ATLAS:
+        entry = FindPackEntry(&assetPack, "atlas_rects", PACK_RECTS);
+        if (entry == NULL || entry->size != sizeof(spriteRects) || !PackImage("atlas", &job->image)) return false;
+        memcpy(spriteRects, PackEntryData(&assetPack, entry), sizeof(spriteRects));
+        break;
+    case JOB_SOUND:
+        snprintf(name, sizeof(name), "sound%d", job->index);
+        entry = FindPackEntry(&assetPack, name, PACK_WAVE);
+        if (entry == NULL || entry->params[0] < 0 || entry->params[2] < 1 || entry->params[3] < 1) return false;
+        if (entry->size != (uint64_t)entry->params[0] * (uint64_t)entry->params[3] * (uint64_t)entry->params[2] / 8)
+            return false;   // The samples must be exactly what the parameters describe
+        job->wave = (Wave){ (unsigned int)entry->params[0], (unsigned int)entry->params[1],
+            (unsigned int)entry->params[2], (unsigned int)entry->params[3], (void*)PackEntryData(&assetPack, entry) };
+        break;
+    case JOB_MUSIC:
+        snprintf(name, sizeof(name), "music%d", job->index);
+        entry = FindPackEntry(&assetPack, name, PACK_FILE_DATA);
+        if (entry == NULL) return false;
+        job->data = (unsigned char*)PackEntryData(&assetPack, entry);
+        job->dataSize = (int)entry->size;
+        break;
+    default:
+        break;
+    }
+    atomic_store(&job->done, true);
+    return true;
+}
+
+// === START LOADING ===
+// With a valid pack every asset is ready at once; otherwise the loose files are decoded on worker threads
+void StartAssetLoading(void)
+{
+    if (OpenAssetPack(&assetPack, PACK_FILE))
+    {
+        QueueJobs(false);
+        bool complete = true;
+        for (int i = 0; i < jobCount && complete; i++)
+            complete = RunPackJob(&jobs[i]);
+        if (complete)
+        {
+            TraceLog(LOG_INFO, "LOADER: Assets mapped from %s", PACK_FILE);
+            return;
+        }
+
+        // Missing entry: forget the pack and load the files
+        TraceLog(LOG_WARNING, "LOADER: %s is incomplete, loading loose files", PACK_FILE);
+        for (int i = 0; i < jobCount; i++)
+        {
+            if (jobs[i].kind == JOB_FONT)
+            {
+                MemFree(jobs[i].glyphs);
+                MemFree(jobs[i].recs);
+            }
+        }
+        CloseAssetPack(&assetPack);
+    }
+
+    QueueJobs(true);
+    StartWorkers();
+}
+
+// === WRITE THE ASSET PACK ===
+// Decodes the loose files exactly like the game does, then stores the results
+bool WriteAssetPack(const char* path)
+{
+    QueueJobs(true);
+    StartWorkers();
+    JoinWorkers();
+
+    bool ok = atomic_load(&atlasJob->done);
+    for (int i = 0; i < jobCount && ok; i++)
+        ok = jobs[i].kind == JOB_SPRITE || jobs[i].image.data || jobs[i].wave.data || jobs[i].data;
+    for (int i = 0; i < SPRITE_NUMBER && ok; i++)
+        ok = spriteRects[i][0].width > 0;   // Every sprite file was found
+
+    // Glyph metrics followed by glyph areas, as the pack stores them, for each size
+    size_t fontDataSize = FONT_GLYPHS * (sizeof(PackGlyph) + sizeof(Rectangle));
+    unsigned char* fontData = malloc(FONT_SIZE_COUNT * fontDataSize);
+    PackWriter writer = { 0 };
+    char names[MAX_LOAD_JOBS][PACK_NAME_LENGTH];
+    char atlasNames[FONT_SIZE_COUNT][PACK_NAME_LENGTH];   // Second entry of each font job
+    for (int i = 0; i < jobCount && ok && fontData; i++)
+    {
+        LoadJob* job = &jobs[i];
+        switch (job->kind)
+        {
+        case JOB_FONT:
+        {
+            PackGlyph* glyphs = (PackGlyph*)(fontData + job->index * fontDataSize);
+            for (int g = 0; g < FONT_GLYPHS; g++)
+                glyphs[g] = (PackGlyph){ job->glyphs[g].value, job->glyphs[g].offsetX, job->glyphs[g].offsetY, job->glyphs[g].advanceX };
+            memcpy(glyphs + FONT_GLYPHS, job->recs, FONT_GLYPHS * sizeof(Rectangle));
+            snprintf(names[i], PACK_NAME_LENGTH, "font%d", fontSizes[job->index]);
+            snprintf(atlasNames[job->index], PACK_NAME_LENGTH, "font_atlas%d", fontSizes[job->index]);
+            AddPackEntry(&writer, names[i], PACK_GLYPHS, glyphs, fontDataSize,
+                FONT_GLYPHS, fontSizes[job->index], FONT_PADDING, 0);
+            AddPackEntry(&writer, atlasNames[job->index], PACK_IMAGE, job->image.data,
+                (size_t)GetPixelDataSize(job->image.width, job->image.height, job->image.format),
+                job->image.width, job->image.height, job->image.format, job->image.mipmaps);
+        }
+        break;
+        case JOB_ATLAS:
+            AddPackEntry(&writer, "atlas", PACK_IMAGE, job->image.data,
+                (size_t)GetPixelDataSize(job->image.width, job->image.height, job->image.format),
+                job->image.width, job->image.height, job->image.format, job->image.mipmaps);
+            AddPackEntry(&writer, "atlas_rects", PACK_RECTS, spriteRects, sizeof(spriteRects), SPRITE_NUMBER * 4, 0, 0, 0);
+            break;
+        case JOB_SOUND:
+            snprintf(names[i], PACK_NAME_LENGTH, "sound%d", job->index);
+            AddPackEntry(&writer, names[i], PACK_WAVE, job->wave.data,
+                (size_t)job->wave.frameCount * job->wave.channels * job->wave.sampleSize / 8,
+                (int32_t)job->wave.frameCount, (int32_t)job->wave.sampleRate, (int32_t)job->wave.sampleSize, (int32_t)job->wave.channels);
+            break;
+        case JOB_MUSIC:
+            snprintf(names[i], PACK_NAME_LENGTH, "music%d", job->index);
+            AddPackEntry(&writer, names[i], PACK_FILE_DATA, job->data, (size_t)job->dataSize, 0, 0, 0, 0);
+            break;
+        default:
+            break;
+        }
+    }
+
+    ok = ok && fontData && FinishAssetPack(&writer, path);
+    if (ok) TraceLog(LOG_INFO, "LOADER: Wrote %d assets to %s", writer.entryCount, path);
+    else TraceLog(LOG_ERROR, "LOADER: Could not write %s (missing asset file?)", path);
+
+    free(fontData);
+    StopAssetLoading(); // Frees everything decoded, nothing was uploaded
+    return ok;
+}
+
+// === UPLOAD ONE FINISHED JOB (MAIN THREAD) ===
+static void UploadJob(LoadJob* job)
+{
+    switch (job->kind)
+    {
+    case JOB_FONT:
+        if (job->glyphs)
+        {
+            Font* font = &fonts[job->index];
+            *font = (Font){ 0 };
+            font->baseSize = fontSizes[job->index];
+            font->glyphCount = FONT_GLYPHS;
+            font->glyphPadding = FONT_PADDING;
+            font->glyphs = job->glyphs;
+            font->recs = job->recs;
+            font->texture = LoadTextureFromImage(job->image);
+            if (!job->borrowed) UnloadImage(job->image);
+        }
+        else
+        {
+            fonts[job->index] = GetFontDefault(); // Missing font: fall back like LoadFont() does
+        }
+        break;
+    case JOB_ATLAS:
+        spriteAtlas = LoadTextureFromImage(job->image);    // One upload for every sprite
+        if (!job->borrowed) UnloadImage(job->image);
+        break;
+    case JOB_SOUND:
+        gameSound[job->index] = LoadSoundFromWave(job->wave);
+        if (!job->borrowed) UnloadWave(job->wave);
+        SetSoundVolume(gameSound[job->index], 1.0f);
+        break;
+    case JOB_MUSIC:
+        if (job->data)
+        {
+            // The stream decodes from the bytes while playing: they stay alive until FreeAssetData()
+            gameMusic[job->index] = LoadMusicStreamFromMemory(".mp3", job->data, job->dataSize);
+            SetMusicVolume(gameMusic[job->index], 1.0f);
+            AttachMusic(job->index, gameMusic[job->index]); // Played from now on by the music service
+        }
+        break;
+    default:
+        break;  // Sprites are consumed by the atlas
+    }
+    job->uploaded = true;
+}
+
+// === UPLOAD WHAT IS READY ===
+void UpdateAssetLoading(void)
+{
+    for (int i = 0; i < jobCount; i++)
+    {
+        if (!jobs[i].uploaded && atomic_load(&jobs[i].done))
+            UploadJob(&jobs[i]);
+    }
+}
+
+// === CHECK IF ASSETS ARE USABLE ===
+bool AssetsReady(unsigned int assets)
+{
+    for (int i = 0; i < jobCount; i++)
+    {
+        if ((jobs[i].asset & assets) && !jobs[i].uploaded)
+            return false;
+    }
+    return true;
+}
+
+// === WAIT FOR ASSETS ===
+void WaitForAssets(unsigned int assets)
+{
+    while (!AssetsReady(assets))
+    {
+        UpdateAssetLoading();
+        thrd_yield();
+    }
+}
+
+// === STOP LOADING ===
+// Called on exit, possibly before everything is loaded
+void StopAssetLoading(void)
+{
+    atomic_store(&cancelLoading, true);
+    JoinWorkers();
+
+    // Free what was decoded but never uploaded
+    for (int i = 0; i < jobCount; i++)
+    {
+        LoadJob* job = &jobs[i];
+        for (int r = 0; r < 4; r++)
+        {
+            UnloadImage(job->variants[r]); // Sprites of an atlas that was never built
+            job->variants[r] = (Image){ 0 };
+        }
+        if (job->uploaded || !atomic_load(&job->done)) continue;
+
+        if (job->kind == JOB_FONT && job->glyphs)
+        {
+            for (int g = 0; g < FONT_GLYPHS; g++) UnloadImage(job->glyphs[g].image);
+            MemFree(job->glyphs);
+            MemFree(job->recs);
+        }
+        if (!job->borrowed)
+        {
+            UnloadImage(job->image);
+            if (job->kind == JOB_SOUND) UnloadWave(job->wave);
+            if (job->kind == JOB_MUSIC) UnloadFileData(job->data);
+        }
+        job->data = NULL;
+        job->uploaded = true; // Nothing left to free
+    }
+}
+
+// === FREE THE MUSIC FILES AND THE PACK ===
+void FreeAssetData(void)
+{
+    for (int i = 0; i < jobCount; i++)
+    {
+        if (jobs[i].kind == JOB_MUSIC && jobs[i].data && !jobs[i].borrowed)
+            UnloadFileData(jobs[i].data);
+        jobs[i].data = NULL;
+    }
+    CloseAssetPack(&assetPack); // Music streams were reading from it
+}
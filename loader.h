@@ -0,0 +1,40 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+// === ASSET GROUPS ===
+// Bit flags naming what a screen needs before it can be shown
+#define ASSET_FONT      (1u << 0)          // Every fonts[i]
+#define ASSET_SPRITES   (1u << 1)          // spriteAtlas and spriteRects
+#define ASSET_SOUNDS    (1u << 2)          // Every gameSound
+#define ASSET_MUSIC(i)  (1u << (8 + (i)))  // gameMusic[i]
+#define ASSET_ALL       (ASSET_FONT | ASSET_SPRITES | ASSET_SOUNDS | (0x3Fu << 8)) // Everything, six music tracks
+
+#define LOADER_THREADS 4   // Worker threads decoding files
+
+// === FUNCTION PROTOTYPES ===
+
+// Map the asset pack, or start decoding the loose files on worker threads (window and audio device must exist)
+void StartAssetLoading(void);
+
+// Upload the assets finished since the last call (main thread, once per frame)
+void UpdateAssetLoading(void);
+
+// Returns true once every asset in the flags is uploaded and usable
+bool AssetsReady(unsigned int assets);
+
+// Wait until every asset in the flags is usable
+void WaitForAssets(unsigned int assets);
+
+// Join the worker threads and free what was decoded but never uploaded
+void StopAssetLoading(void);
+
+// Free the encoded music files and unmap the asset pack (after FreeMusic)
+void FreeAssetData(void);
+
+// Decode the loose asset files and store them in a pack (offline, no window needed)
+bool WriteAssetPack(const char* path);
+
+#endif // LOADER_H
@@ -1,16 +1,59 @@
 #include <raylib.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "game.h"
 #include "ressources.h"
 #include "snake.h"
 #include "food.h"
 #include "hint.h"
+#include "batch.h"
+#include "arena.h"
+#include "net.h"
+#include "loader.h"
+#include "pack.h"
+#include "replay.h"
 
 // === MAIN ENTRY POINT ===
 // Initializes the game, runs the main loop, and frees resources on exit
-int main(void)
+int main(int argc, char** argv)
 {
+    // Headless batch of bot games: no window, no audio
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+        return RunBatch(argc, argv);
+
+    // Headless arena of many bot snakes on one board
+    if (argc > 1 && strcmp(argv[1], "--arena") == 0)
+        return RunArena(argc, argv);
+
+    // Authoritative game server, and a server and a bot client checked over loopback
+    if (argc > 1 && strcmp(argv[1], "--server") == 0)
+        return RunServer(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "--netcheck") == 0)
+        return RunNetCheck(argc, argv);
+
+    // Check a recorded game and print its state at a tick
+    if (argc > 1 && strcmp(argv[1], "--replay") == 0)
+        return RunReplay(argc, argv);
+
+    // Offline asset packer: decode the loose files once, write the pack the game maps
+    if (argc > 1 && strcmp(argv[1], "--pack") == 0)
+        return WriteAssetPack(argc > 2 ? argv[2] : PACK_FILE) ? 0 : 1;
+
+    // Board larger (or smaller) than the window: --board COLUMNSxROWS
+    // Feast mode, many fruits on the board at once: --feast [K]
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--board") == 0 && i + 1 < argc)
+            sscanf(argv[++i], "%dx%d", &boardColumns, &boardRows);
+        else if (strcmp(argv[i], "--feast") == 0)
+        {
+            feastFruits = FEAST_FRUITS;
+            if (i + 1 < argc && argv[i + 1][0] != '-') feastFruits = atoi(argv[++i]);
+        }
+    }
+
     // Initialize the snake game: window, audio, textures, variables
     InitSnakeGame();
 
@@ -0,0 +1,1023 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "net.h"
+#include "sim.h"
+#include "board.h"
+#include "controller.h"
+
+// === CONSTANTS ===
+#define SNAPSHOT_FULL (1u << 2)         // Snapshot flag: no baseline, the whole state follows
+#define SNAPSHOT_FRUIT (1u << 3)        // Snapshot flag: the fruits changed since the baseline
+#define NET_MAX_FRAME_TIME 250.0f       // Longest pause the server clock catches up on
+#define NET_RECEIVE_BUFFER (1 << 20)    // Socket receive buffer: bursts of delayed packets fit
+
+// Movement of one tile for each direction
+static const Cell netDelta[4] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+
+// === PACKET OUTPUT ===
+// Same LEB128 varints as the replays; writes past the end mark the packet failed
+typedef struct NetWriter
+{
+    unsigned char* data;
+    int size;
+    bool failed;
+} NetWriter;
+
+static void WriteNetByte(NetWriter* writer, unsigned char byte)
+{
+    if (writer->size >= NET_MAX_PACKET)
+    {
+        writer->failed = true;
+        return;
+    }
+    writer->data[writer->size++] = byte;
+}
+
+static void WriteNetVarint(NetWriter* writer, uint32_t value)
+{
+    do
+    {
+        unsigned char byte = (unsigned char)(value & 0x7F);
+        value >>= 7;
+        WriteNetByte(writer, value ? (unsigned char)(byte | 0x80) : byte);
+    } while (value);
+}
+
+// Zigzag: the head is off the board after a crash into a border
+static void WriteNetSigned(NetWriter* writer, int value)
+{
+    WriteNetVarint(writer, ((uint32_t)value << 1) ^ (uint32_t)-(int32_t)(value < 0));
+}
+
+// === PACKET INPUT ===
+typedef struct NetReader
+{
+    const unsigned char* position;
+    const unsigned char* end;
+    bool failed;
+} NetReader;
+
+static uint32_t ReadNetVarint(NetReader* reader)
+{
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (reader->position >= reader->end) break;
+        unsigned char byte = *reader->position++;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    reader->failed = true;
+    return 0;
+}
+
+static int ReadNetSigned(NetReader* reader)
+{
+    uint32_t value = ReadNetVarint(reader);
+    return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+// Reads a varint that must lie in [minimum, maximum]
+static int ReadNetRange(NetReader* reader, int minimum, int maximum)
+{
+    uint32_t value = ReadNetVarint(reader);
+    if ((int64_t)value < minimum || (int64_t)value > maximum) reader->failed = true;
+    return reader->failed ? minimum : (int)value;
+}
+
+// === RANDOM FLOAT IN [0, 1) ===
+static float NetRandom(NetLink* link)
+{
+    return (float)(NextRng(&link->random) >> 8) * (1.0f / 16777216.0f);
+}
+
+// === OPEN A SOCKET ===
+bool OpenNetLink(NetLink* link, uint16_t port, NetConditions conditions, unsigned int seed)
+{
+    *link = (NetLink){ 0 };
+    link->socket = -1;
+    link->conditions = conditions;
+    SeedRng(&link->random, seed, RNG_STREAM_NETWORK);
+
+#ifdef _WIN32
+    static bool started = false;
+    WSADATA data;
+    if (!started && WSAStartup(MAKEWORD(2, 2), &data) != 0) return false;
+    started = true;
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_SOCKET) return false;
+#else
+    int handle = socket(AF_INET, SOCK_DGRAM, 0);
+    if (handle < 0) return false;
+#endif
+    link->socket = (intptr_t)handle;
+
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+    int bufferSize = NET_RECEIVE_BUFFER;
+    setsockopt(handle, SOL_SOCKET, SO_RCVBUF, (const char*)&bufferSize, sizeof(bufferSize));
+
+    bool ok = bind(handle, (struct sockaddr*)&address, sizeof(address)) == 0 &&
+        getsockname(handle, (struct sockaddr*)&address, &length) == 0;
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ok = ok && ioctlsocket(handle, FIONBIO, &nonBlocking) == 0;
+#else
+    ok = ok && fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    if (!ok)
+    {
+        CloseNetLink(link);
+        return false;
+    }
+    link->address = (NetAddress){ ntohl(address.sin_addr.s_addr), ntohs(address.sin_port) };
+    return true;
+}
+
+// === REALLY SEND A PACKET ===
+static void SendNow(NetLink* link, NetAddress to, const unsigned char* data, int size)
+{
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(to.host);
+    address.sin_port = htons(to.port);
+    sendto(link->socket, (const char*)data, size, 0, (struct sockaddr*)&address, sizeof(address)); // Lost like any datagram on failure
+}
+
+// === SEND A PACKET ===
+void SendNetPacket(NetLink* link, NetAddress to, const unsigned char* data, int size, double now)
+{
+    link->packetsSent++;
+    link->bytesSent += size;
+    if (link->conditions.loss > 0.0f && NetRandom(link) < link->conditions.loss)
+    {
+        link->packetsDropped++;
+        return;
+    }
+
+    float delay = link->conditions.latency + link->conditions.jitter * NetRandom(link);
+    unsigned char* copy = (delay > 0.0f && link->delayedCount < NET_MAX_DELAYED) ? malloc((size_t)size) : NULL;
+    if (!copy)
+    {
+        SendNow(link, to, data, size);
+        return;
+    }
+    memcpy(copy, data, (size_t)size);
+    link->delayed[link->delayedCount++] = (NetDelayed){ now + delay, to, copy, size };
+}
+
+// === RECEIVE A PACKET ===
+int ReceiveNetPacket(NetLink* link, NetAddress* from, unsigned char* data, int capacity, double now)
+{
+    // Delayed packets whose time has come leave first
+    for (int i = 0; i < link->delayedCount; )
+    {
+        NetDelayed* delayed = &link->delayed[i];
+        if (delayed->due > now)
+        {
+            i++;
+            continue;
+        }
+        SendNow(link, delayed->to, delayed->data, delayed->size);
+        free(delayed->data);
+        *delayed = link->delayed[--link->delayedCount];
+    }
+
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    int size = (int)recvfrom(link->socket, (char*)data, capacity, 0, (struct sockaddr*)&address, &length);
+    if (size <= 0) return 0;
+    *from = (NetAddress){ ntohl(address.sin_addr.s_addr), ntohs(address.sin_port) };
+    return size;
+}
+
+// === CLOSE A SOCKET ===
+void CloseNetLink(NetLink* link)
+{
+    if (link->socket != -1)
+    {
+#ifdef _WIN32
+        closesocket((SOCKET)link->socket);
+#else
+        close((int)link->socket);
+#endif
+    }
+    for (int i = 0; i < link->delayedCount; i++)
+        free(link->delayed[i].data);
+    link->delayedCount = 0;
+    link->socket = -1;
+}
+
+// === SERVER: REMEMBER A TICK ===
+static void RecordNetHistory(NetServer* server)
+{
+    const GameState* game = &server->game;
+    server->history[game->tickCounter % NET_HISTORY] = (NetHistory){ server->gameNumber, game->tickCounter,
+        game->fenceCount, server->fruitVersion };
+}
+
+// Returns the history of a tick of the current game, or NULL if it was overwritten
+static const NetHistory* FindNetHistory(const NetServer* server, int game, int tick)
+{
+    if (tick < 0) return NULL;
+    const NetHistory* history = &server->history[tick % NET_HISTORY];
+    return (history->game == game && history->tick == tick) ? history : NULL;
+}
+
+// === SERVER: READ AN INPUT PACKET ===
+static void ReadInputPacket(NetServer* server, NetAddress from, const unsigned char* data, int size, double now)
+{
+    NetReader reader = { data + 1, data + size, false };
+    int game = ReadNetRange(&reader, 0, INT32_MAX) - 1;
+    int ackTick = ReadNetRange(&reader, 0, INT32_MAX);
+    uint32_t echo = ReadNetVarint(&reader);
+    int count = ReadNetRange(&reader, 0, NET_MAX_INPUTS);
+    if (reader.failed) return;
+
+    // Known client, or a new one in a free slot
+    NetRemote* remote = NULL;
+    for (int i = 0; i < NET_MAX_CLIENTS && !remote; i++)
+    {
+        if (server->remotes[i].connected && server->remotes[i].address.host == from.host &&
+            server->remotes[i].address.port == from.port)
+            remote = &server->remotes[i];
+    }
+    for (int i = 0; i < NET_MAX_CLIENTS && !remote; i++)
+    {
+        if (!server->remotes[i].connected)
+        {
+            remote = &server->remotes[i];
+            *remote = (NetRemote){ 0 };
+            remote->connected = true;
+            remote->address = from;
+            remote->ackGame = -1;
+            remote->sentGame = -1;
+        }
+    }
+    if (!remote) return; // Server full
+
+    remote->lastHeard = now;
+    remote->echo = echo;
+    if (game > remote->ackGame || (game == remote->ackGame && ackTick > remote->ackTick))
+    {
+        remote->ackGame = game;
+        remote->ackTick = ackTick;
+    }
+
+    // Turns already applied or queued are resends; turns of an older game are dropped
+    for (int i = 0; i < count; i++)
+    {
+        NetInput input;
+        input.sequence = ReadNetVarint(&reader);
+        input.tick = ReadNetRange(&reader, 0, INT32_MAX);
+        input.turn = (Direction)ReadNetRange(&reader, DIRECTION_UP, DIRECTION_LEFT);
+        if (reader.failed || game != server->gameNumber) return;
+
+        uint32_t last = remote->inputCount ? remote->inputs[remote->inputCount - 1].sequence : remote->applied;
+        if (input.sequence > last && remote->inputCount < NET_MAX_INPUTS)
+            remote->inputs[remote->inputCount++] = input;
+    }
+}
+
+// === SERVER: APPLY THE TURN DUE ON THE NEXT TICK ===
+// One turn per tick, the oldest first, exactly like the client predicts it
+static void ApplyDueInput(NetServer* server)
+{
+    int next = server->game.tickCounter + 1;
+    for (int i = 0; i < NET_MAX_CLIENTS; i++)
+    {
+        NetRemote* remote = &server->remotes[i];
+        if (!remote->connected || remote->inputCount == 0 || remote->inputs[0].tick > next) continue;
+
+        ApplyGameInput(&server->game, (GameInput){ remote->inputs[0].turn });
+        remote->applied = remote->inputs[0].sequence;
+        memmove(remote->inputs, remote->inputs + 1, sizeof(NetInput) * (size_t)--remote->inputCount);
+        return;
+    }
+}
+
+// === SERVER: SEND A SNAPSHOT ===
+// Delta against the last snapshot the client applied when it is still in the
+// history and the snake kept every head pushed since; full otherwise
+static void SendSnapshot(NetServer* server, NetRemote* remote, double now)
+{
+    static unsigned char packet[NET_MAX_PACKET];
+    const GameState* game = &server->game;
+    const Snake* snake = &game->snake;
+    int tick = game->tickCounter;
+
+    const NetHistory* base = NULL;
+    if (remote->ackGame == server->gameNumber && remote->ackTick <= tick && tick - remote->ackTick <= snake->length)
+        base = FindNetHistory(server, server->gameNumber, remote->ackTick);
+
+    bool fruitChanged = !base || base->fruitVersion != server->fruitVersion;
+    uint32_t flags = (uint32_t)game->over | (uint32_t)game->won << 1 |
+        (base ? 0u : SNAPSHOT_FULL) | (fruitChanged ? SNAPSHOT_FRUIT : 0u);
+    uint32_t intervalBits;
+    memcpy(&intervalBits, &game->tickInterval, sizeof(intervalBits)); // Exact float
+
+    NetWriter writer = { packet, 0, false };
+    WriteNetByte(&writer, NET_SNAPSHOT);
+    WriteNetVarint(&writer, (uint32_t)server->gameNumber);
+    WriteNetVarint(&writer, (uint32_t)tick);
+    WriteNetVarint(&writer, flags);
+    if (base) WriteNetVarint(&writer, (uint32_t)base->tick);
+    WriteNetVarint(&writer, remote->applied);
+    WriteNetVarint(&writer, remote->echo);
+    if (!base)
+    {
+        WriteNetVarint(&writer, (uint32_t)game->board.columns);
+        WriteNetVarint(&writer, (uint32_t)game->board.rows);
+        WriteNetVarint(&writer, (uint32_t)game->fruitTarget);
+    }
+    WriteNetVarint(&writer, (uint32_t)game->direction);
+    WriteNetVarint(&writer, (uint32_t)game->nextDirection);
+    WriteNetVarint(&writer, (uint32_t)game->score);
+    WriteNetVarint(&writer, intervalBits);
+    WriteNetVarint(&writer, (uint32_t)snake->length);
+    WriteNetVarint(&writer, (uint32_t)snake->growth);
+    if (fruitChanged)
+    {
+        WriteNetVarint(&writer, (uint32_t)game->fruitCount);
+        for (int i = 0; i < game->fruitCount; i++)
+        {
+            WriteNetVarint(&writer, (uint32_t)game->fruits[i].position.x);
+            WriteNetVarint(&writer, (uint32_t)game->fruits[i].position.y);
+            WriteNetVarint(&writer, (uint32_t)game->fruits[i].type);
+        }
+    }
+
+    // Fences added since the baseline
+    int fenceBase = base ? base->fenceCount : 0;
+    WriteNetVarint(&writer, (uint32_t)fenceBase);
+    WriteNetVarint(&writer, (uint32_t)(game->fenceCount - fenceBase));
+    for (int i = fenceBase; i < game->fenceCount; i++)
+    {
+        WriteNetVarint(&writer, (uint32_t)game->fencePositions[i].x);
+        WriteNetVarint(&writer, (uint32_t)game->fencePositions[i].y);
+    }
+
+    // Heads pushed since the baseline (the whole body without one), four steps per byte
+    int steps = base ? tick - base->tick : snake->length;
+    WriteNetVarint(&writer, (uint32_t)steps);
+    if (steps > 0)
+    {
+        Cell previous = SnakeSegment(snake, 0);
+        WriteNetSigned(&writer, previous.x);
+        WriteNetSigned(&writer, previous.y);
+        unsigned char byte = 0;
+        for (int i = 1; i < steps; i++)
+        {
+            Cell segment = SnakeSegment(snake, i);
+            unsigned char step = (segment.x > previous.x) ? DIRECTION_RIGHT : (segment.x < previous.x) ? DIRECTION_LEFT :
+                (segment.y > previous.y) ? DIRECTION_DOWN : DIRECTION_UP;
+            byte |= (unsigned char)(step << (2 * ((i - 1) % 4)));
+            if ((i - 1) % 4 == 3 || i == steps - 1)
+            {
+                WriteNetByte(&writer, byte);
+                byte = 0;
+            }
+            previous = segment;
+        }
+    }
+    if (writer.failed) return; // Larger than a datagram: the client keeps its last state
+
+    SendNetPacket(&server->link, remote->address, packet, writer.size, now);
+    remote->lastSent = now;
+    remote->sentGame = server->gameNumber;
+    remote->sentTick = tick;
+    server->snapshots++;
+    server->snapshotBytes += writer.size;
+    if (writer.size > server->largestSnapshot) server->largestSnapshot = writer.size;
+}
+
+// === START A SERVER ===
+bool InitNetServer(NetServer* server, int columns, int rows, unsigned int seed, uint16_t port, NetConditions conditions)
+{
+    *server = (NetServer){ 0 };
+    if (!OpenNetLink(&server->link, port, conditions, seed)) return false;
+    if (!InitGameState(&server->game, columns, rows, seed))
+    {
+        CloseNetLink(&server->link);
+        return false;
+    }
+    for (int i = 0; i < NET_HISTORY; i++) server->history[i].game = -1;
+    server->seed = seed;
+    server->lastUpdate = -1.0;
+    server->overSince = -1.0;
+    RecordNetHistory(server);
+    return true;
+}
+
+// === UPDATE THE SERVER ===
+void NetServerUpdate(NetServer* server, double now)
+{
+    static unsigned char packet[NET_MAX_PACKET];
+    NetAddress from;
+    int size;
+    while ((size = ReceiveNetPacket(&server->link, &from, packet, NET_MAX_PACKET, now)) > 0)
+    {
+        if (packet[0] == NET_INPUT) ReadInputPacket(server, from, packet, size, now);
+    }
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++)
+    {
+        if (server->remotes[i].connected && now - server->remotes[i].lastHeard > NET_TIMEOUT)
+            server->remotes[i].connected = false;
+    }
+
+    // --- Run the ticks that are due ---
+    float elapsed = (server->lastUpdate < 0.0) ? 0.0f : (float)(now - server->lastUpdate);
+    if (elapsed > NET_MAX_FRAME_TIME) elapsed = NET_MAX_FRAME_TIME;
+    server->lastUpdate = now;
+    server->tickAccumulator += elapsed;
+    while (server->tickAccumulator >= server->game.tickInterval && !server->game.over)
+    {
+        server->tickAccumulator -= server->game.tickInterval;
+        ApplyDueInput(server);
+        uint32_t events = GameStep(&server->game, (GameInput){ DIRECTION_NONE });
+        if (events & (EVENT_ATE_FRUIT | EVENT_FRUIT_SPAWN)) server->fruitVersion++;
+        RecordNetHistory(server);
+    }
+
+    // --- Next game a while after the end ---
+    if (server->game.over)
+    {
+        if (server->overSince < 0.0) server->overSince = now;
+        else if (now - server->overSince >= NET_RESTART_DELAY)
+        {
+            server->seed = server->seed * 1664525u + 1013904223u; // Same sequence as GameReset()
+            SeedGameState(&server->game, server->seed);
+            ResetGameState(&server->game);
+            server->gameNumber++;
+            server->fruitVersion++;
+            server->tickAccumulator = 0.0f;
+            server->overSince = -1.0;
+            for (int i = 0; i < NET_MAX_CLIENTS; i++) server->remotes[i].inputCount = 0;
+            RecordNetHistory(server);
+        }
+    }
+
+    // --- Snapshots: every new tick, and again now and then until acknowledged ---
+    for (int i = 0; i < NET_MAX_CLIENTS; i++)
+    {
+        NetRemote* remote = &server->remotes[i];
+        if (!remote->connected) continue;
+        bool sent = remote->sentGame == server->gameNumber && remote->sentTick == server->game.tickCounter;
+        bool acknowledged = remote->ackGame == server->gameNumber && remote->ackTick == server->game.tickCounter;
+        if (!sent || (!acknowledged && now - remote->lastSent >= NET_RESEND_INTERVAL))
+            SendSnapshot(server, remote, now);
+    }
+}
+
+// === STOP A SERVER ===
+void FreeNetServer(NetServer* server)
+{
+    CloseNetLink(&server->link);
+    FreeGameState(&server->game);
+}
+
+// === CLIENT: PUSH A HEAD ON THE MIRROR ===
+static void PushMirrorHead(GameState* game, Cell cell)
+{
+    Snake* snake = &game->snake;
+    if (snake->length > 0)
+    {
+        Cell head = SnakeSegment(snake, 0);
+        int index = BoardIndex(&game->board, head);
+        Direction exit = (cell.x > head.x) ? DIRECTION_RIGHT : (cell.x < head.x) ? DIRECTION_LEFT :
+            (cell.y > head.y) ? DIRECTION_DOWN : DIRECTION_UP;
+        if (index >= 0) snake->exits[index] = (unsigned char)exit;
+    }
+    snake->headIndex = (snake->headIndex == 0) ? snake->capacity - 1 : snake->headIndex - 1;
+    snake->cells[snake->headIndex] = cell;
+    snake->length++;
+    SetBoardCell(&game->board, cell, CELL_BODY);
+}
+
+// === CLIENT: APPLY A SNAPSHOT TO THE MIRROR ===
+// Everything is read and checked before the mirror changes; returns true if it moved forward
+static bool ApplySnapshot(NetClient* client, const unsigned char* data, int size, double now)
+{
+    GameState* mirror = &client->mirror;
+    NetReader reader = { data + 1, data + size, false };
+    int game = ReadNetRange(&reader, 0, INT32_MAX);
+    int tick = ReadNetRange(&reader, 0, INT32_MAX);
+    uint32_t flags = ReadNetVarint(&reader);
+    bool full = (flags & SNAPSHOT_FULL) != 0;
+    int baseTick = full ? 0 : ReadNetRange(&reader, 0, tick);
+    uint32_t applied = ReadNetVarint(&reader);
+    uint32_t echo = ReadNetVarint(&reader);
+    if (reader.failed || game < client->gameNumber) return false;
+
+    // Round trip and applied turns, even from a snapshot with nothing new
+    float roundTrip = (float)((uint32_t)now - echo);
+    if (echo != 0 && roundTrip >= 0.0f && roundTrip < NET_TIMEOUT)
+        client->roundTrip = (client->roundTrip == 0.0f) ? roundTrip : client->roundTrip * 0.9f + roundTrip * 0.1f;
+    bool sameGame = (game == client->gameNumber);
+    if (sameGame)
+    {
+        int dropped = 0;
+        while (dropped < client->inputCount && client->inputs[dropped].sequence <= applied) dropped++;
+        client->inputCount -= dropped;
+        memmove(client->inputs, client->inputs + dropped, sizeof(NetInput) * (size_t)client->inputCount);
+        if (tick <= mirror->tickCounter) return false;   // Repeated or late
+    }
+
+    // A delta needs the mirror somewhere between its baseline and its tick
+    if (!full && (!sameGame || mirror->tickCounter < baseTick)) return false;
+    int columns = mirror->board.columns, rows = mirror->board.rows;
+    int fruitTarget = mirror->fruitTarget;
+    if (full)
+    {
+        columns = ReadNetRange(&reader, START_LENGTH + 2, 65535);
+        rows = ReadNetRange(&reader, 1, 65535);
+        fruitTarget = ReadNetRange(&reader, 1, columns * rows);
+    }
+    Direction direction = (Direction)ReadNetRange(&reader, DIRECTION_UP, DIRECTION_LEFT);
+    Direction nextDirection = (Direction)ReadNetRange(&reader, DIRECTION_UP, DIRECTION_LEFT);
+    int score = ReadNetRange(&reader, 0, INT32_MAX);
+    uint32_t intervalBits = ReadNetVarint(&reader);
+    int length = ReadNetRange(&reader, 1, columns * rows);
+    int growth = ReadNetRange(&reader, 0, INT32_MAX);
+    int fruitCount = (flags & SNAPSHOT_FRUIT) ? ReadNetRange(&reader, 0, columns * rows) : 0;
+    if (reader.failed) return false;
+    Fruit* fruits = malloc(sizeof(Fruit) * (size_t)(fruitCount > 0 ? fruitCount : 1));
+    if (!fruits) return false;
+    for (int i = 0; i < fruitCount; i++)
+    {
+        fruits[i].position.x = ReadNetRange(&reader, 0, columns - 1);
+        fruits[i].position.y = ReadNetRange(&reader, 0, rows - 1);
+        fruits[i].type = (FruitType)ReadNetRange(&reader, 0, FRUIT_COUNT - 1);
+    }
+    int fenceBase = ReadNetRange(&reader, 0, MAX_FENCES);
+    int newFences = ReadNetRange(&reader, 0, MAX_FENCES - fenceBase);
+    Cell fences[MAX_FENCES];
+    for (int i = 0; i < newFences; i++)
+    {
+        fences[i].x = ReadNetRange(&reader, 0, columns - 1);
+        fences[i].y = ReadNetRange(&reader, 0, rows - 1);
+    }
+    int steps = ReadNetRange(&reader, 0, columns * rows);
+    Cell head = { 0, 0 };
+    if (steps > 0)
+    {
+        head.x = ReadNetSigned(&reader);
+        head.y = ReadNetSigned(&reader);
+    }
+    const unsigned char* stepBytes = reader.position;
+    int pushes = full ? length : tick - mirror->tickCounter;
+    if (reader.failed || (reader.end - stepBytes) < (steps + 2) / 4 ||
+        (full ? steps != length : (pushes > steps || fenceBase > mirror->fenceCount || mirror->fenceCount > fenceBase + newFences)))
+    {
+        free(fruits);
+        return false;
+    }
+
+    // --- A new game or another board size starts from an empty mirror ---
+    if (full && (columns != mirror->board.columns || rows != mirror->board.rows))
+    {
+        FreeGameState(mirror);
+        FreeGameState(&client->predicted);
+        if (!InitGameState(mirror, columns, rows, 0) || !InitGameState(&client->predicted, columns, rows, 0))
+        {
+            client->gameNumber = -1;
+            free(fruits);
+            return false;
+        }
+    }
+    if (full)
+    {
+        ClearBoard(&mirror->board);
+        mirror->snake.length = 0;
+        mirror->snake.headIndex = 0;
+        mirror->fenceCount = 0;
+        mirror->fruitTarget = fruitTarget;
+    }
+    if (!sameGame)
+    {
+        client->inputCount = 0;   // Turns of the previous game
+        client->gameNumber = game;
+    }
+
+    // --- Tail first: the pushed heads may enter tiles it left ---
+    if (pushes > length) pushes = length;
+    while (mirror->snake.length > length - pushes)
+    {
+        SetBoardCell(&mirror->board, SnakeSegment(&mirror->snake, mirror->snake.length - 1), CELL_EMPTY);
+        mirror->snake.length--;
+    }
+    if (flags & SNAPSHOT_FRUIT) ClearFruits(mirror);
+    for (int i = mirror->fenceCount - fenceBase; i < newFences; i++)
+    {
+        mirror->fencePositions[mirror->fenceCount++] = fences[i];
+        SetBoardCell(&mirror->board, fences[i], CELL_FENCE);
+    }
+
+    // --- Heads, oldest first: segment i is i steps behind the new head ---
+    Cell* segments = malloc(sizeof(Cell) * (size_t)(pushes > 0 ? pushes : 1));
+    if (!segments)
+    {
+        free(fruits);
+        return false;
+    }
+    Cell cell = head;
+    for (int i = 0; i < pushes; i++)
+    {
+        segments[i] = cell;
+        if (i + 1 < pushes)
+        {
+            int step = (stepBytes[i / 4] >> (2 * (i % 4))) & 3;
+            cell.x += netDelta[step].x;
+            cell.y += netDelta[step].y;
+        }
+    }
+    for (int i = pushes - 1; i >= 0; i--)
+        PushMirrorHead(mirror, segments[i]);
+    free(segments);
+    if (full) RestoreSnakeExits(mirror);
+
+    // --- Everything else is sent as it is ---
+    mirror->direction = direction;
+    mirror->nextDirection = nextDirection;
+    mirror->score = score;
+    memcpy(&mirror->tickInterval, &intervalBits, sizeof(intervalBits));
+    mirror->snake.growth = growth;
+    mirror->over = (flags & 1) != 0;
+    mirror->won = (flags & 2) != 0;
+    for (int i = 0; i < fruitCount; i++)
+        PlaceFruit(mirror, fruits[i].position, fruits[i].type);
+    free(fruits);
+    mirror->tickCounter = tick;
+
+    // Was the head where the prediction put it?
+    if (sameGame && client->predicted.tickCounter >= tick)
+    {
+        Cell predicted = client->predictedHeads[tick % NET_HISTORY];
+        Cell actual = SnakeSegment(&mirror->snake, 0);
+        if (predicted.x != actual.x || predicted.y != actual.y) client->mispredictions++;
+    }
+
+    client->snapshotTime = now;
+    client->snapshots++;
+    client->snapshotBytes += size;
+    return true;
+}
+
+// === CLIENT: STEP THE PREDICTION ===
+// Same rule as the server: before each step, the oldest turn due by then
+static void Predict(NetClient* client, int target)
+{
+    GameState* predicted = &client->predicted;
+    while (predicted->tickCounter < target && !predicted->over)
+    {
+        int next = predicted->tickCounter + 1;
+        if (client->predictedInputs < client->inputCount && client->inputs[client->predictedInputs].tick <= next)
+            ApplyGameInput(predicted, (GameInput){ client->inputs[client->predictedInputs++].turn });
+        GameStep(predicted, (GameInput){ DIRECTION_NONE });
+        client->predictedHeads[predicted->tickCounter % NET_HISTORY] = SnakeSegment(&predicted->snake, 0);
+    }
+}
+
+// === OPEN A CLIENT ===
+bool InitNetClient(NetClient* client, int columns, int rows, NetAddress server, NetConditions conditions, unsigned int seed)
+{
+    *client = (NetClient){ 0 };
+    if (!OpenNetLink(&client->link, 0, conditions, seed + 1)) return false;   // Not the server's loss pattern
+    if (!InitGameState(&client->mirror, columns, rows, 0) || !InitGameState(&client->predicted, columns, rows, 0))
+    {
+        FreeNetClient(client);
+        return false;
+    }
+    client->server = server;
+    client->gameNumber = -1;
+    client->nextSequence = 1;
+    client->lastSent = -NET_SEND_INTERVAL;
+    return true;
+}
+
+// === QUEUE A TURN ===
+// Meant for the next predicted step, and never for the same step as the previous turn
+void NetClientTurn(NetClient* client, Direction turn)
+{
+    if (client->gameNumber < 0 || client->inputCount == NET_MAX_INPUTS) return;
+
+    int tick = client->predicted.tickCounter + 1;
+    if (client->inputCount > 0 && client->inputs[client->inputCount - 1].tick >= tick)
+        tick = client->inputs[client->inputCount - 1].tick + 1;
+    client->inputs[client->inputCount++] = (NetInput){ client->nextSequence++, tick, turn };
+}
+
+// === UPDATE THE CLIENT ===
+void NetClientUpdate(NetClient* client, double now)
+{
+    static unsigned char packet[NET_MAX_PACKET];
+    NetAddress from;
+    int size;
+    int previousGame = client->gameNumber;
+    int previousTick = client->predicted.tickCounter;
+    bool applied = false;
+    while ((size = ReceiveNetPacket(&client->link, &from, packet, NET_MAX_PACKET, now)) > 0)
+    {
+        if (packet[0] == NET_SNAPSHOT && from.host == client->server.host && from.port == client->server.port)
+            applied |= ApplySnapshot(client, packet, size, now);
+    }
+
+    if (client->gameNumber >= 0)
+    {
+        // Start again from the server's word, then replay the turns it has not applied
+        if (applied)
+        {
+            CopyGameState(&client->predicted, &client->mirror);
+            client->predictedInputs = 0;
+        }
+
+        // The server is half a round trip further than the mirror, and a turn sent
+        // now takes another half to arrive: predict up to then, never backwards
+        float interval = client->mirror.tickInterval;
+        float halfTrip = client->roundTrip * 0.5f;
+        int target = client->mirror.tickCounter + (int)(((float)(now - client->snapshotTime) + halfTrip) / interval) +
+            (int)(halfTrip / interval + 0.999f);
+        if (client->gameNumber == previousGame && target < previousTick) target = previousTick;
+        Predict(client, target);
+    }
+
+    // --- Acknowledgement and every turn not applied yet ---
+    if (now - client->lastSent < NET_SEND_INTERVAL) return;
+    NetWriter writer = { packet, 0, false };
+    WriteNetByte(&writer, NET_INPUT);
+    WriteNetVarint(&writer, (uint32_t)(client->gameNumber + 1));
+    WriteNetVarint(&writer, (uint32_t)(client->gameNumber >= 0 ? client->mirror.tickCounter : 0));
+    WriteNetVarint(&writer, (uint32_t)now);
+    WriteNetVarint(&writer, (uint32_t)client->inputCount);
+    for (int i = 0; i < client->inputCount; i++)
+    {
+        WriteNetVarint(&writer, client->inputs[i].sequence);
+        WriteNetVarint(&writer, (uint32_t)client->inputs[i].tick);
+        WriteNetVarint(&writer, (uint32_t)client->inputs[i].turn);
+    }
+    SendNetPacket(&client->link, client->server, packet, writer.size, now);
+    client->lastSent = now;
+}
+
+// === CLOSE A CLIENT ===
+void FreeNetClient(NetClient* client)
+{
+    CloseNetLink(&client->link);
+    FreeGameState(&client->mirror);
+    FreeGameState(&client->predicted);
+}
+
+// === CHECKSUM OF A GAME ===
+// FNV-1a over what the rules and the screen depend on (the free list order left out)
+static uint32_t GameChecksum(const GameState* game)
+{
+    uint32_t hash = 2166136261u;
+#define HASH(value) (hash = (hash ^ (uint32_t)(value)) * 16777619u)
+    for (int i = 0; i < game->snake.length; i++)
+    {
+        Cell cell = SnakeSegment(&game->snake, i);
+        HASH(cell.x);
+        HASH(cell.y);
+    }
+    for (int i = 0; i < game->fenceCount; i++)
+    {
+        HASH(game->fencePositions[i].x);
+        HASH(game->fencePositions[i].y);
+    }
+    for (int i = 0; i < game->board.columns * game->board.rows; i++)
+        HASH(game->board.cells[i]);
+    for (int i = 0; i < game->fruitCount; i++)
+    {
+        HASH(game->fruits[i].position.y * game->board.columns + game->fruits[i].position.x);
+        HASH(game->fruits[i].type);
+    }
+    HASH(game->score);
+    HASH(game->direction);
+    HASH(game->nextDirection);
+    HASH(game->snake.growth);
+    HASH(game->over);
+#undef HASH
+    return hash;
+}
+
+static double GetMilliseconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1e6;
+}
+
+// === PARSE THE SHARED OPTIONS ===
+// Returns false on an unknown option or a bad value; the caller handles its own options first
+static bool ParseNetOption(const char* option, const char* value, NetConditions* conditions,
+    unsigned int* seed, int* columns, int* rows)
+{
+    if (strcmp(option, "--loss") == 0) conditions->loss = (float)atof(value);
+    else if (strcmp(option, "--latency") == 0) conditions->latency = (float)atof(value);
+    else if (strcmp(option, "--jitter") == 0) conditions->jitter = (float)atof(value);
+    else if (strcmp(option, "--seed") == 0) *seed = (unsigned int)strtoul(value, NULL, 10);
+    else if (strcmp(option, "--board") == 0) return sscanf(value, "%dx%d", columns, rows) == 2;
+    else return false;
+    return true;
+}
+
+static void PrintServerUsage(const char* program)
+{
+    fprintf(stderr, "usage: %s --server [--port P] [--board COLUMNSxROWS] [--seed S] [--loss L] [--latency MS] [--jitter MS]\n", program);
+}
+
+static void PrintNetCheckUsage(const char* program)
+{
+    fprintf(stderr, "usage: %s --netcheck [--ticks T] [--board COLUMNSxROWS] [--seed S] [--loss L] "
+        "[--latency MS] [--jitter MS] [--controller NAME]\ncontrollers:", program);
+    for (int i = 0; i < GetControllerCount(); i++)
+        fprintf(stderr, " %s", GetController(i)->name);
+    fprintf(stderr, "\n");
+}
+
+// === RUN A STANDALONE SERVER ===
+int RunServer(int argc, char** argv)
+{
+    NetConditions conditions = { 0 };
+    unsigned int seed = (unsigned int)time(NULL);
+    int columns = 15, rows = 15;   // Same as the window
+    int port = NET_PORT;
+    for (int i = 1; i < argc; i++)
+    {
+        const char* option = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = true;
+
+        if (strcmp(option, "--server") == 0) continue;
+        else if (!value) ok = false;
+        else if (strcmp(option, "--port") == 0) port = atoi(value);
+        else ok = ParseNetOption(option, value, &conditions, &seed, &columns, &rows);
+
+        if (!ok)
+        {
+            PrintServerUsage(argv[0]);
+            return 1;
+        }
+        i++; // Skip the value
+    }
+
+    NetServer server;
+    if (port <= 0 || port > 65535 || !InitNetServer(&server, columns, rows, seed, (uint16_t)port, conditions))
+    {
+        fprintf(stderr, "cannot start a server on port %d\n", port);
+        return 1;
+    }
+    printf("serving a %dx%d board on 127.0.0.1:%d\n", columns, rows, server.link.address.port);
+
+    // Runs until killed; a line per finished game
+    int reported = -1;
+    for (;;)
+    {
+        NetServerUpdate(&server, GetMilliseconds());
+        if (server.game.over && reported != server.gameNumber)
+        {
+            reported = server.gameNumber;
+            printf("game %d: score %d, %d ticks, %lld snapshots, %.1f bytes each\n", server.gameNumber,
+                server.game.score, server.game.tickCounter, server.snapshots,
+                server.snapshots ? (double)server.snapshotBytes / (double)server.snapshots : 0.0);
+            fflush(stdout);
+        }
+        thrd_sleep(&(struct timespec){ .tv_nsec = 1000000 }, NULL);
+    }
+}
+
+// === SERVER AND BOT CLIENT OVER LOOPBACK ===
+// Runs on a simulated clock (1 ms per loop) so long games take seconds. Every
+// applied snapshot is compared with the server's game at the same tick.
+int RunNetCheck(int argc, char** argv)
+{
+    NetConditions conditions = { 0.1f, 40.0f, 20.0f };
+    unsigned int seed = (unsigned int)time(NULL);
+    int columns = 15, rows = 15;
+    int ticks = 5000;
+    const char* controllerName = "greedy";
+    for (int i = 1; i < argc; i++)
+    {
+        const char* option = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool ok = true;
+
+        if (strcmp(option, "--netcheck") == 0) continue;
+        else if (!value) ok = false;
+        else if (strcmp(option, "--ticks") == 0) ticks = atoi(value);
+        else if (strcmp(option, "--controller") == 0)
+        {
+            controllerName = value;
+            ok = (FindController(value) != NULL);
+        }
+        else ok = ParseNetOption(option, value, &conditions, &seed, &columns, &rows);
+
+        if (!ok)
+        {
+            PrintNetCheckUsage(argv[0]);
+            return 1;
+        }
+        i++; // Skip the value
+    }
+
+    const Controller* controller = FindController(controllerName);
+    NetServer* server = malloc(sizeof(NetServer));
+    NetClient* client = malloc(sizeof(NetClient));
+    uint32_t* checksums = malloc(sizeof(uint32_t) * NET_HISTORY);   // Server's game at each recent tick
+    long long* checksumTags = malloc(sizeof(long long) * NET_HISTORY); // Game and tick of each slot
+    if (!controller || !server || !client || !checksums || !checksumTags ||
+        !InitNetServer(server, columns, rows, seed, 0, conditions))
+    {
+        fprintf(stderr, "cannot start the check\n");
+        free(server); free(client); free(checksums); free(checksumTags);
+        return 1;
+    }
+    if (!InitNetClient(client, columns, rows, server->link.address, conditions, seed))
+    {
+        fprintf(stderr, "cannot start the client\n");
+        FreeNetServer(server);
+        free(server); free(client); free(checksums); free(checksumTags);
+        return 1;
+    }
+    void* data = controller->create(&client->predicted);
+    for (int i = 0; i < NET_HISTORY; i++) checksumTags[i] = -1;
+
+    long long totalTicks = 0, checked = 0, mismatched = 0;
+    int longest = 0, serverGame = -1, serverTick = -1, mirrorGame = -1, mirrorTick = -1, decided = -1;
+    double now = 1.0;
+    while (totalTicks < ticks && data)
+    {
+        NetServerUpdate(server, now);
+        if (server->gameNumber != serverGame || server->game.tickCounter != serverTick)
+        {
+            if (server->gameNumber == serverGame) totalTicks += server->game.tickCounter - serverTick;
+            serverGame = server->gameNumber;
+            serverTick = server->game.tickCounter;
+            checksums[serverTick % NET_HISTORY] = GameChecksum(&server->game);
+            checksumTags[serverTick % NET_HISTORY] = (long long)serverGame << 32 | serverTick;
+            if (server->game.snake.length > longest) longest = server->game.snake.length;
+        }
+
+        NetClientUpdate(client, now);
+        if (client->gameNumber != mirrorGame || client->mirror.tickCounter != mirrorTick)
+        {
+            if (client->gameNumber != mirrorGame) controller->reset(data, &client->predicted, (unsigned int)client->gameNumber);
+            mirrorGame = client->gameNumber;
+            mirrorTick = client->mirror.tickCounter;
+            if (mirrorGame >= 0 && checksumTags[mirrorTick % NET_HISTORY] == ((long long)mirrorGame << 32 | mirrorTick))
+            {
+                checked++;
+                mismatched += checksums[mirrorTick % NET_HISTORY] != GameChecksum(&client->mirror);
+            }
+        }
+
+        // The bot plays on the predicted game, once per predicted tick
+        if (client->gameNumber >= 0 && client->predicted.tickCounter != decided && !client->predicted.over)
+        {
+            decided = client->predicted.tickCounter;
+            GameInput input = controller->decide(data, &client->predicted);
+            if (input.turn != DIRECTION_NONE && input.turn != client->predicted.nextDirection)
+                NetClientTurn(client, input.turn);
+        }
+        now += 1.0;
+    }
+
+    printf("%lld ticks over %d games, %.0f%% loss, %.0f ms latency + %.0f ms jitter each way\n",
+        totalTicks, server->gameNumber + 1, conditions.loss * 100.0f, conditions.latency, conditions.jitter);
+    printf("snapshots: %lld sent, %lld applied, %.1f bytes each, largest %d; snake length up to %d\n",
+        server->snapshots, client->snapshots, server->snapshots ? (double)server->snapshotBytes / (double)server->snapshots : 0.0,
+        server->largestSnapshot, longest);
+    printf("inputs: %lld packets, %.1f bytes each; round trip %.0f ms\n", client->link.packetsSent,
+        client->link.packetsSent ? (double)client->link.bytesSent / (double)client->link.packetsSent : 0.0, client->roundTrip);
+    printf("%lld snapshots checked against the server, %lld mismatched, %lld heads mispredicted\n",
+        checked, mismatched, client->mispredictions);
+
+    if (data) controller->destroy(data);
+    FreeNetClient(client);
+    FreeNetServer(server);
+    free(server);
+    free(client);
+    free(checksums);
+    free(checksumTags);
+    return (mismatched == 0 && checked > 0) ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#ifndef NET_H
+#define NET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rng.h"     // Simulated loss and latency
+#include "sim.h"     // Game state and directions
+
+// === AUTHORITATIVE SERVER OVER UDP ===
+// The server owns the only real game and steps it on the fixed-timestep
+// clock. Clients send timestamped turns and get back one snapshot per tick,
+// delta-coded against the last snapshot they acknowledged:
+//
+//   INPUT    game ackTick clientTime count (sequence tick direction)*
+//   SNAPSHOT game tick flags [baseTick] appliedSequence echoTime [columns rows fruitTarget]
+//            direction nextDirection score tickInterval length growth [fruitCount fruit*]
+//            fenceBase fenceCount fences* steps headX headY (2-bit step towards the tail)*
+//
+// The snake is a queue, so going from the baseline to the current tick only
+// pushed one head per tick and dropped some tail: a delta carries the new
+// head tiles as 2-bit steps plus the final length, never the body. Fences are
+// only ever appended and the fruits are sent when one was eaten or spawned. A snapshot costs
+// the ticks since the acknowledged one, whatever the length of the snake;
+// a client without a usable baseline gets a full snapshot instead.
+//
+// Turns are resent with every input packet until a snapshot reports them
+// applied, so a lost packet only delays them. Each one carries the tick it was
+// meant for: the client predicts by replaying its unapplied turns on a copy of
+// the last snapshot, up to the tick the server will be at when they arrive.
+// Moves and crashes come out as the server will compute them; fruits and
+// fences spawned by the prediction may land elsewhere until the next snapshot.
+//
+// Both ends can drop and delay their own packets to test on localhost:
+//   TheSnakeman --server [--port P] [--seed S] [--loss L] [--latency MS] [--jitter MS]
+//   TheSnakeman --netcheck [--ticks T] [--loss L] [--latency MS] [--jitter MS]
+//                          [--seed S] [--controller NAME]
+
+// === CONSTANTS ===
+#define NET_PORT 47800                 // Default server port
+#define NET_MAX_PACKET 65507           // Largest UDP payload (full snapshots of long snakes)
+#define NET_MAX_CLIENTS 4              // Clients a server accepts
+#define NET_MAX_INPUTS 16              // Turns queued per client and resent per packet
+#define NET_HISTORY 256                // Ticks a baseline can be behind the current one
+#define NET_SEND_INTERVAL 16.0         // Milliseconds between two input packets of a client
+#define NET_RESEND_INTERVAL 100.0      // Milliseconds before a snapshot is repeated when no tick happened
+#define NET_TIMEOUT 5000.0             // Milliseconds of silence before a client is dropped
+#define NET_RESTART_DELAY 2000.0       // Milliseconds between the end of a game and the next one
+#define NET_MAX_DELAYED 1024           // Packets a link can hold back for simulated latency
+
+// === KINDS OF PACKETS ===
+typedef enum NetPacket
+{
+    NET_INPUT = 'I',         // Client to server: acknowledgement and turns
+    NET_SNAPSHOT = 'S'       // Server to client: state of one tick
+} NetPacket;
+
+// === ADDRESS (IPv4, host byte order) ===
+typedef struct NetAddress
+{
+    uint32_t host;
+    uint16_t port;
+} NetAddress;
+
+// === SIMULATED NETWORK CONDITIONS ===
+typedef struct NetConditions
+{
+    float loss;              // Probability that a sent packet is dropped
+    float latency;           // Milliseconds every packet is held back
+    float jitter;            // Extra random delay, up to this many milliseconds (reorders packets)
+} NetConditions;
+
+// Packet held back by the simulated latency
+typedef struct NetDelayed
+{
+    double due;              // When it is really sent
+    NetAddress to;
+    unsigned char* data;
+    int size;
+} NetDelayed;
+
+// === UDP ENDPOINT ===
+typedef struct NetLink
+{
+    intptr_t socket;         // Non-blocking UDP socket, -1 when closed
+    NetAddress address;      // Where the socket is bound
+    NetConditions conditions;
+    Rng random;              // Drops and delays
+    NetDelayed delayed[NET_MAX_DELAYED];
+    int delayedCount;
+    long long packetsSent;   // Packets given to Send, dropped ones included
+    long long packetsDropped;
+    long long bytesSent;
+} NetLink;
+
+// === ONE TURN ===
+typedef struct NetInput
+{
+    uint32_t sequence;       // Numbered from 1 by the client
+    int tick;                // Tick of the step that should apply it
+    Direction turn;          // Requested direction
+} NetInput;
+
+// === SERVER SIDE OF A CLIENT ===
+typedef struct NetRemote
+{
+    bool connected;
+    NetAddress address;
+    int ackGame;             // Game of the last snapshot the client applied (-1 = none)
+    int ackTick;             // Tick of that snapshot
+    uint32_t applied;        // Last turn applied to the game
+    NetInput inputs[NET_MAX_INPUTS]; // Received and not applied yet, in sequence order
+    int inputCount;
+    uint32_t echo;           // Client time of its last packet, sent back for the round trip
+    double lastHeard;        // When its last packet arrived
+    double lastSent;         // When it was last sent a snapshot
+    int sentGame;            // Game of that snapshot
+    int sentTick;            // Tick of that snapshot
+} NetRemote;
+
+// What a delta needs to know about an older tick
+typedef struct NetHistory
+{
+    int game;                // Game number, -1 for an empty slot
+    int tick;
+    int fenceCount;
+    int fruitVersion;        // Fruit version of the server at that tick
+} NetHistory;
+
+// === SERVER ===
+typedef struct NetServer
+{
+    NetLink link;
+    GameState game;          // The authoritative game
+    int gameNumber;          // Increases with every new game
+    unsigned int seed;       // Seed of the current game
+    float tickAccumulator;   // Real time not yet consumed by ticks
+    double lastUpdate;       // Time of the previous NetServerUpdate()
+    double overSince;        // When the current game ended
+    int fruitVersion;        // Changes whenever a fruit is eaten or spawned
+    NetRemote remotes[NET_MAX_CLIENTS];
+    NetHistory history[NET_HISTORY];
+    long long snapshots;     // Snapshots sent
+    long long snapshotBytes; // Their total size
+    int largestSnapshot;     // Largest one, in bytes
+} NetServer;
+
+// === CLIENT ===
+typedef struct NetClient
+{
+    NetLink link;
+    NetAddress server;
+    GameState mirror;        // Last snapshot applied: the server's game at mirror.tickCounter
+    GameState predicted;     // Mirror plus the unapplied turns, stepped to the predicted tick
+    int gameNumber;          // Game of the mirror (-1 before the first snapshot)
+    uint32_t nextSequence;   // Number of the next turn
+    NetInput inputs[NET_MAX_INPUTS]; // Turns not applied by the server yet
+    int inputCount;
+    double snapshotTime;     // When the last snapshot was applied
+    float roundTrip;         // Smoothed round trip (ms)
+    double lastSent;         // When the last input packet was sent
+    int predictedInputs;     // Turns of inputs[] already applied to the prediction
+    Cell predictedHeads[NET_HISTORY]; // Head predicted for each tick, to count mispredictions
+    long long snapshots;     // Snapshots applied
+    long long snapshotBytes; // Their total size
+    long long mispredictions; // Snapshots whose head differs from the predicted one
+} NetClient;
+
+// === FUNCTION PROTOTYPES ===
+
+// Open a UDP socket on 127.0.0.1:port (0 = any port); returns false on failure
+bool OpenNetLink(NetLink* link, uint16_t port, NetConditions conditions, unsigned int seed);
+
+// Send a packet, or drop or delay it as the conditions say
+void SendNetPacket(NetLink* link, NetAddress to, const unsigned char* data, int size, double now);
+
+// Send the delayed packets that are due; returns the size of a received packet, 0 if none
+int ReceiveNetPacket(NetLink* link, NetAddress* from, unsigned char* data, int capacity, double now);
+
+// Close the socket and free the delayed packets
+void CloseNetLink(NetLink* link);
+
+// Start a server and its first game; returns false on failure
+bool InitNetServer(NetServer* server, int columns, int rows, unsigned int seed, uint16_t port, NetConditions conditions);
+
+// Read the inputs, run the due ticks and send the snapshots (now in milliseconds)
+void NetServerUpdate(NetServer* server, double now);
+
+// Stop the server
+void FreeNetServer(NetServer* server);
+
+// Open a client for a server; returns false on failure
+bool InitNetClient(NetClient* client, int columns, int rows, NetAddress server, NetConditions conditions, unsigned int seed);
+
+// Queue a turn for the next predicted step
+void NetClientTurn(NetClient* client, Direction turn);
+
+// Read the snapshots, advance the prediction and send the turns (now in milliseconds)
+void NetClientUpdate(NetClient* client, double now);
+
+// Close the client
+void FreeNetClient(NetClient* client);
+
+// Command-line modes: a standalone server, and a server and a bot client over loopback
+int RunServer(int argc, char** argv);
+int RunNetCheck(int argc, char** argv);
+
+#endif // NET_H
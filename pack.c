@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "pack.h"
+
+// === MAP THE FILE ===
+static bool MapFile(AssetPack* pack, const char* path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file); // The mapping keeps the file open
+    if (mapping == NULL) return false;
+
+    pack->base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (pack->base == NULL)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    pack->size = (size_t)size.QuadPart;
+    pack->handle = mapping;
+    return true;
+#else
+    int file = open(path, O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat info;
+    void* base = MAP_FAILED;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // The mapping keeps the file open
+    if (base == MAP_FAILED) return false;
+
+    pack->base = base;
+    pack->size = (size_t)info.st_size;
+    pack->handle = NULL;
+    return true;
+#endif
+}
+
+// === OPEN A PACK ===
+bool OpenAssetPack(AssetPack* pack, const char* path)
+{
+    *pack = (AssetPack){ 0 };
+    if (!MapFile(pack, path)) return false;
+
+    // Reject anything this build did not write
+    const PackHeader* header = (const PackHeader*)pack->base;
+    bool valid = pack->size >= sizeof(PackHeader)
+        && header->magic == PACK_MAGIC
+        && header->version == PACK_VERSION
+        && header->entryCount <= PACK_MAX_ENTRIES
+        && pack->size >= sizeof(PackHeader) + header->entryCount * sizeof(PackEntry);
+
+    if (valid)
+    {
+        pack->entries = (const PackEntry*)(pack->base + sizeof(PackHeader));
+        pack->entryCount = (int)header->entryCount;
+        for (int i = 0; i < pack->entryCount && valid; i++)
+        {
+            const PackEntry* entry = &pack->entries[i];
+            valid = entry->offset <= pack->size && entry->size <= pack->size - entry->offset
+                && memchr(entry->name, '\0', PACK_NAME_LENGTH) != NULL;
+        }
+    }
+
+    if (!valid) CloseAssetPack(pack);
+    return valid;
+}
+
+// === FIND AN ENTRY ===
+const PackEntry* FindPackEntry(const AssetPack* pack, const char* name, PackEntryType type)
+{
+    for (int i = 0; i < pack->entryCount; i++)
+    {
+        if (pack->entries[i].type == (uint32_t)type && strcmp(pack->entries[i].name, name) == 0)
+            return &pack->entries[i];
+    }
+    return NULL;
+}
+
+// === DATA OF AN ENTRY ===
+const void* PackEntryData(const AssetPack* pack, const PackEntry* entry)
+{
+    return pack->base + entry->offset;
+}
+
+// === CLOSE A PACK ===
+void CloseAssetPack(AssetPack* pack)
+{
+    if (pack->base != NULL)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(pack->base);
+        CloseHandle(pack->handle);
+#else
+        munmap((void*)pack->base, pack->size);
+#endif
+    }
+    *pack = (AssetPack){ 0 };
+}
+
+// === ADD AN ENTRY TO A NEW PACK ===
+void AddPackEntry(PackWriter* writer, const char* name, PackEntryType type,
+    const void* data, size_t size, int32_t p0, int32_t p1, int32_t p2, int32_t p3)
+{
+    if (writer->entryCount >= PACK_MAX_ENTRIES || size > UINT32_MAX || strlen(name) >= PACK_NAME_LENGTH)
+    {
+        writer->overflow = true;
+        return;
+    }
+
+    PackEntry* entry = &writer->entries[writer->entryCount];
+    *entry = (PackEntry){ 0 };
+    strcpy(entry->name, name);
+    entry->type = (uint32_t)type;
+    entry->size = (uint32_t)size;
+    entry->params[0] = p0;
+    entry->params[1] = p1;
+    entry->params[2] = p2;
+    entry->params[3] = p3;
+    writer->payloads[writer->entryCount] = data;
+    writer->entryCount++;
+}
+
+// === WRITE A PACK ===
+bool FinishAssetPack(const PackWriter* writer, const char* path)
+{
+    if (writer->overflow) return false;
+
+    // Lay the payloads out after the table
+    PackHeader header = { PACK_MAGIC, PACK_VERSION, (uint32_t)writer->entryCount, 0 };
+    PackEntry entries[PACK_MAX_ENTRIES];
+    uint64_t offset = sizeof(PackHeader) + writer->entryCount * sizeof(PackEntry);
+    for (int i = 0; i < writer->entryCount; i++)
+    {
+        offset = (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+        entries[i] = writer->entries[i];
+        entries[i].offset = (uint32_t)offset;
+        offset += entries[i].size;
+    }
+    if (offset > UINT32_MAX) return false;
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(entries, sizeof(PackEntry), (size_t)writer->entryCount, file) == (size_t)writer->entryCount;
+
+    static const unsigned char zeros[PACK_ALIGNMENT] = { 0 };
+    long position = (long)(sizeof(PackHeader) + writer->entryCount * sizeof(PackEntry));
+    for (int i = 0; i < writer->entryCount && ok; i++)
+    {
+        size_t gap = entries[i].offset - (size_t)position;  // Alignment padding
+        ok = fwrite(zeros, 1, gap, file) == gap
+            && fwrite(writer->payloads[i], 1, entries[i].size, file) == entries[i].size;
+        position = (long)(entries[i].offset + entries[i].size);
+    }
+
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
@@ -0,0 +1,103 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// === ASSET PACK FORMAT ===
+// One file holding every asset already decoded, mapped into memory at startup:
+//
+//   PackHeader | PackEntry[entryCount] | payloads (each aligned to PACK_ALIGNMENT)
+//
+// Numbers are stored in the byte order of the machine that built the pack;
+// a pack with another magic or version is ignored and the loose files are used.
+
+// === CONSTANTS ===
+#define PACK_MAGIC 0x4B504E53u      // "SNPK" read as a little-endian integer
+#define PACK_VERSION 2              // Bump whenever the layout or an entry changes
+#define PACK_FILE "Assets/snakeman.pack" // Where the game looks for the pack
+#define PACK_NAME_LENGTH 32         // Entry name size, zero terminated
+#define PACK_MAX_ENTRIES 64         // Entries a pack can hold
+#define PACK_ALIGNMENT 16           // Payload alignment inside the file
+
+// === KINDS OF ENTRIES ===
+typedef enum PackEntryType
+{
+    PACK_IMAGE,       // Raw pixels: params = width, height, raylib pixel format, mipmaps
+    PACK_RECTS,       // Array of raylib Rectangle: params[0] = count
+    PACK_GLYPHS,      // PackGlyph array then Rectangle array: params = count, base size, padding
+    PACK_WAVE,        // Raw samples: params = frame count, sample rate, sample size, channels
+    PACK_FILE_DATA    // Bytes of a file kept encoded (streamed music)
+} PackEntryType;
+
+// === HEADER ===
+typedef struct PackHeader
+{
+    uint32_t magic;        // PACK_MAGIC
+    uint32_t version;      // PACK_VERSION
+    uint32_t entryCount;   // Entries in the table following the header
+    uint32_t reserved;     // Zero
+} PackHeader;
+
+// === ONE ENTRY OF THE TABLE ===
+typedef struct PackEntry
+{
+    char name[PACK_NAME_LENGTH]; // Unique name, e.g. "atlas" or "music3"
+    uint32_t type;               // PackEntryType
+    uint32_t offset;             // Payload position from the start of the file
+    uint32_t size;               // Payload size in bytes
+    int32_t params[4];           // Meaning depends on the type (see PackEntryType)
+} PackEntry;
+
+// === GLYPH METRICS OF A FONT ENTRY ===
+typedef struct PackGlyph
+{
+    int32_t value;      // Unicode code point
+    int32_t offsetX;    // Drawing offset
+    int32_t offsetY;    // Drawing offset
+    int32_t advanceX;   // Horizontal advance
+} PackGlyph;
+
+// === MAPPED PACK ===
+typedef struct AssetPack
+{
+    const unsigned char* base;   // Start of the mapping (NULL when closed)
+    size_t size;                 // Size of the file
+    const PackEntry* entries;    // Entry table inside the mapping
+    int entryCount;              // Entries in the table
+    void* handle;                // Platform mapping handle
+} AssetPack;
+
+// === PACK BEING WRITTEN ===
+// Payloads are only referenced: they must stay alive until FinishAssetPack()
+typedef struct PackWriter
+{
+    PackEntry entries[PACK_MAX_ENTRIES];      // Table being built
+    const void* payloads[PACK_MAX_ENTRIES];   // Data of each entry
+    int entryCount;                           // Entries added so far
+    bool overflow;                            // Too many entries or too much data
+} PackWriter;
+
+// === FUNCTION PROTOTYPES ===
+
+// Map a pack read-only and check its header and table; false if missing or invalid
+bool OpenAssetPack(AssetPack* pack, const char* path);
+
+// Find an entry of the given type by name; NULL if absent
+const PackEntry* FindPackEntry(const AssetPack* pack, const char* name, PackEntryType type);
+
+// Payload of an entry, inside the mapping
+const void* PackEntryData(const AssetPack* pack, const PackEntry* entry);
+
+// Unmap the pack (nothing read from it may be used afterwards)
+void CloseAssetPack(AssetPack* pack);
+
+// Add an entry to a pack being written
+void AddPackEntry(PackWriter* writer, const char* name, PackEntryType type,
+    const void* data, size_t size, int32_t p0, int32_t p1, int32_t p2, int32_t p3);
+
+// Write the header, the table and every payload; false on error
+bool FinishAssetPack(const PackWriter* writer, const char* path);
+
+#endif // PACK_H
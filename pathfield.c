@@ -0,0 +1,271 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pathfield.h"
+#include "board.h"
+
+// Marks of the cells visited by ClosePathCell()
+#define MARK_NONE 0       // Not looked at
+#define MARK_QUEUED 1     // Waiting to be checked
+#define MARK_KEPT 2       // Still has a shortest path that avoids the closed cell
+#define MARK_LOST 3       // Every shortest path went through the closed cell
+
+// === INITIALIZE PATH FIELD ===
+bool InitPathField(PathField* field, int columns, int rows)
+{
+    *field = (PathField){ 0 };
+    field->columns = columns;
+    field->rows = rows;
+
+    size_t cellCount = (size_t)columns * (size_t)rows;
+    field->distance = malloc(sizeof(int) * cellCount);
+    field->blocked = calloc(cellCount, 1);
+    field->target = calloc(cellCount, 1);
+    field->mark = calloc(cellCount, 1);
+    field->queue = malloc(sizeof(int) * cellCount);
+    field->seeds = malloc(sizeof(uint64_t) * cellCount);
+
+    if (!field->distance || !field->blocked || !field->target || !field->mark || !field->queue || !field->seeds)
+    {
+        FreePathField(field);    // Empty field to indicate failure
+        return false;
+    }
+    for (size_t i = 0; i < cellCount; i++)
+        field->distance[i] = PATH_UNREACHABLE;
+    return true;
+}
+
+// === LIST THE NEIGHBOURS OF A CELL ===
+// Returns how many of the four neighbours lie on the board
+static int Neighbours(const PathField* field, int index, int neighbours[4])
+{
+    int x = index % field->columns;
+    int count = 0;
+    if (index >= field->columns) neighbours[count++] = index - field->columns;                 // Up
+    if (x + 1 < field->columns) neighbours[count++] = index + 1;                               // Right
+    if (index + field->columns < field->columns * field->rows) neighbours[count++] = index + field->columns; // Down
+    if (x > 0) neighbours[count++] = index - 1;                                                // Left
+    return count;
+}
+
+// === BREADTH-FIRST WAVE ===
+// Expands the cells already in the queue; a neighbour is only visited again
+// when the wave brings it a shorter distance
+static void SpreadPathField(PathField* field, int head, int tail)
+{
+    int neighbours[4];
+    while (head < tail)
+    {
+        int index = field->queue[head++];
+        int next = field->distance[index] + 1;
+        int count = Neighbours(field, index, neighbours);
+        for (int i = 0; i < count; i++)
+        {
+            int neighbour = neighbours[i];
+            if (field->blocked[neighbour] || field->distance[neighbour] <= next) continue;
+            field->distance[neighbour] = next;
+            field->queue[tail++] = neighbour;
+        }
+    }
+}
+
+// === BUILD THE WHOLE FIELD ===
+// Body segments and fences block the way; every fruit tile is a target
+void BuildPathField(PathField* field, const Board* board)
+{
+    int cellCount = field->columns * field->rows;
+    int targets = 0;
+    for (int i = 0; i < cellCount; i++)
+    {
+        field->blocked[i] = (board->cells[i] == CELL_BODY || board->cells[i] == CELL_FENCE);
+        field->target[i] = (board->cells[i] == CELL_FRUIT);
+        field->distance[i] = field->target[i] ? 0 : PATH_UNREACHABLE;
+        if (field->target[i]) field->queue[targets++] = i;   // All at distance 0: the queue is in order
+    }
+    SpreadPathField(field, 0, targets);
+}
+
+// === ADD A TARGET ===
+void AddPathTarget(PathField* field, int index)
+{
+    if (field->target[index] || field->blocked[index]) return;
+    field->target[index] = 1;
+    field->distance[index] = 0;
+    field->queue[0] = index;
+    SpreadPathField(field, 0, 1);
+}
+
+static int CompareSeeds(const void* a, const void* b)
+{
+    uint64_t left = *(const uint64_t*)a;
+    uint64_t right = *(const uint64_t*)b;
+    return (left > right) - (left < right);
+}
+
+// === CLOSE A CELL ===
+void ClosePathCell(PathField* field, int index)
+{
+    if (field->blocked[index]) return;
+    field->blocked[index] = 1;
+    field->target[index] = 0;   // A covered fruit is gone: paths now lead to the others
+
+    int closed = field->distance[index];
+    field->distance[index] = PATH_UNREACHABLE;
+    if (closed == PATH_UNREACHABLE) return;   // No path used it
+
+    // Walk down the distances from the closed cell. Cells come out of the
+    // queue in increasing distance, so all the cells one step closer to a
+    // target are settled before a cell checks whether one of them still leads there.
+    int neighbours[4];
+    int head = 0;
+    int tail = 0;
+    int count = Neighbours(field, index, neighbours);
+    for (int i = 0; i < count; i++)
+    {
+        if (field->distance[neighbours[i]] == closed + 1 && !field->blocked[neighbours[i]])
+        {
+            field->mark[neighbours[i]] = MARK_QUEUED;
+            field->queue[tail++] = neighbours[i];
+        }
+    }
+    while (head < tail)
+    {
+        int cell = field->queue[head++];
+        int parent = field->distance[cell] - 1;
+        count = Neighbours(field, cell, neighbours);
+
+        bool kept = false;
+        for (int i = 0; i < count && !kept; i++)
+        {
+            int neighbour = neighbours[i];
+            kept = !field->blocked[neighbour] && field->mark[neighbour] != MARK_LOST &&
+                   field->distance[neighbour] == parent;
+        }
+        field->mark[cell] = kept ? MARK_KEPT : MARK_LOST;
+        if (kept) continue;
+
+        // Its children may have lost their only way as well
+        for (int i = 0; i < count; i++)
+        {
+            int neighbour = neighbours[i];
+            if (field->mark[neighbour] == MARK_NONE && !field->blocked[neighbour] &&
+                field->distance[neighbour] == parent + 2)
+            {
+                field->mark[neighbour] = MARK_QUEUED;
+                field->queue[tail++] = neighbour;
+            }
+        }
+    }
+
+    // Forget the lost distances, then restart each lost cell from its best
+    // valid neighbour. Seeds are packed as distance << 32 | index to sort them.
+    int lostCount = 0;
+    for (int i = 0; i < tail; i++)
+    {
+        int cell = field->queue[i];
+        if (field->mark[cell] == MARK_LOST)
+        {
+            field->distance[cell] = PATH_UNREACHABLE;
+            field->queue[lostCount++] = cell;   // Compact in place, behind the read position
+        }
+        else
+            field->mark[cell] = MARK_NONE;
+    }
+    int seedCount = 0;
+    for (int i = 0; i < lostCount; i++)
+    {
+        int cell = field->queue[i];
+        field->mark[cell] = MARK_NONE;
+
+        int best = PATH_UNREACHABLE;
+        count = Neighbours(field, cell, neighbours);
+        for (int j = 0; j < count; j++)
+        {
+            int distance = field->distance[neighbours[j]];
+            if (!field->blocked[neighbours[j]] && distance < best) best = distance;
+        }
+        if (best != PATH_UNREACHABLE)
+            field->seeds[seedCount++] = ((uint64_t)(best + 1) << 32) | (uint32_t)cell;
+    }
+    qsort(field->seeds, (size_t)seedCount, sizeof(uint64_t), CompareSeeds);
+
+    // Breadth-first wave fed by two sorted sources: the seeds and the queue.
+    // Taking the smaller distance each time keeps the queue in order.
+    head = 0;
+    tail = 0;
+    int seed = 0;
+    while (seed < seedCount || head < tail)
+    {
+        int cell;
+        if (head < tail && (seed == seedCount ||
+            (uint64_t)field->distance[field->queue[head]] <= (field->seeds[seed] >> 32)))
+        {
+            cell = field->queue[head++];
+        }
+        else
+        {
+            int distance = (int)(field->seeds[seed] >> 32);
+            cell = (int)(field->seeds[seed++] & 0xffffffffu);
+            if (field->distance[cell] <= distance) continue;  // The wave got there first
+            field->distance[cell] = distance;
+        }
+
+        int next = field->distance[cell] + 1;
+        count = Neighbours(field, cell, neighbours);
+        for (int i = 0; i < count; i++)
+        {
+            int neighbour = neighbours[i];
+            if (field->blocked[neighbour] || field->distance[neighbour] <= next) continue;
+            field->distance[neighbour] = next;
+            field->queue[tail++] = neighbour;
+        }
+    }
+}
+
+// === OPEN A CELL ===
+void OpenPathCell(PathField* field, int index)
+{
+    if (!field->blocked[index]) return;
+    field->blocked[index] = 0;
+
+    int best = PATH_UNREACHABLE;
+    if (field->target[index])
+        best = 0;
+    else
+    {
+        int neighbours[4];
+        int count = Neighbours(field, index, neighbours);
+        for (int i = 0; i < count; i++)
+        {
+            int distance = field->distance[neighbours[i]];
+            if (!field->blocked[neighbours[i]] && distance != PATH_UNREACHABLE && distance + 1 < best)
+                best = distance + 1;
+        }
+    }
+    if (best == PATH_UNREACHABLE) return;   // Still cut off from every target
+
+    field->distance[index] = best;
+    field->queue[0] = index;
+    SpreadPathField(field, 0, 1);
+}
+
+// === READ A DISTANCE ===
+int PathDistance(const PathField* field, Cell cell)
+{
+    if (cell.x < 0 || cell.x >= field->columns || cell.y < 0 || cell.y >= field->rows)
+        return PATH_UNREACHABLE;
+    return field->distance[cell.y * field->columns + cell.x];
+}
+
+// === FREE PATH FIELD MEMORY ===
+void FreePathField(PathField* field)
+{
+    free(field->distance);
+    free(field->blocked);
+    free(field->target);
+    free(field->mark);
+    free(field->queue);
+    free(field->seeds);
+    *field = (PathField){ 0 };
+}
@@ -0,0 +1,64 @@
+#ifndef PATHFIELD_H
+#define PATHFIELD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "board.h"   // Occupancy grid and cell coordinates
+
+// === DISTANCE FIELD ===
+// Number of moves from every cell of the board to the nearest target cell (a
+// fruit), going around snake segments and fences. The field is built with a
+// breadth-first search from every target at once, then kept exact while cells
+// open and close and targets appear:
+// - opening a cell can only shorten paths, so a BFS wave starts from it and
+//   stops where distances no longer improve;
+// - closing a cell only invalidates the cells whose every shortest path went
+//   through it; they are found by walking down the distances from the closed
+//   cell and re-solved from their still valid neighbours (a closed target is
+//   no longer one: the head eating a fruit closes its tile);
+// - a new target is a cell opened at distance 0.
+// A snake move closes the new head tile and opens the old tail tile, so each
+// tick costs the size of the region behind the head instead of the whole board.
+
+// === CONSTANTS ===
+#define PATH_UNREACHABLE 0x7fffffff   // Distance of blocked cells and cells cut off from the target
+
+// === PATH FIELD STRUCT ===
+typedef struct PathField
+{
+    int* distance;           // Moves to the nearest target for each cell, or PATH_UNREACHABLE
+    unsigned char* blocked;  // 1 for cells the snake cannot enter (body, fences)
+    unsigned char* target;   // 1 for target cells
+    unsigned char* mark;     // Scratch marks of ClosePathCell()
+    int* queue;              // Scratch BFS queue (one entry per cell)
+    uint64_t* seeds;         // Scratch list of cells to re-solve, sorted by distance
+    int columns;             // Number of tiles horizontally
+    int rows;                // Number of tiles vertically
+} PathField;
+
+// === FUNCTION PROTOTYPES ===
+
+// Allocate a field for a board of the given size; returns false on allocation failure
+bool InitPathField(PathField* field, int columns, int rows);
+
+// Rebuild the whole field from the board towards every fruit on it
+void BuildPathField(PathField* field, const Board* board);
+
+// Make a free cell a target (a new fruit) and propagate the shorter distances it gives
+void AddPathTarget(PathField* field, int index);
+
+// Mark a cell as blocked and repair the distances that went through it
+void ClosePathCell(PathField* field, int index);
+
+// Mark a cell as free and propagate the shorter distances it allows
+void OpenPathCell(PathField* field, int index);
+
+// Returns the number of moves from a cell to the nearest target, or PATH_UNREACHABLE
+int PathDistance(const PathField* field, Cell cell);
+
+// Free the field memory
+void FreePathField(PathField* field);
+
+#endif // PATHFIELD_H
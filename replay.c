@@ -0,0 +1,668 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "replay.h"
+#include "sim.h"
+#include "board.h"
+
+// === CONSTANTS ===
+#define REPLAY_MAGIC "SNRP"      // First four bytes of every replay
+#define TRAILER_SIZE 4           // Offset of the keyframe index, at the very end
+
+// === BYTE OUTPUT ===
+// Every write goes through here; on allocation failure the replay is marked
+// failed and later writes are dropped
+static void WriteBytes(ReplayWriter* writer, const void* bytes, size_t count)
+{
+    if (writer->failed) return;
+    if (writer->size + count > writer->capacity)
+    {
+        size_t capacity = writer->capacity ? writer->capacity : 4096;
+        while (capacity < writer->size + count) capacity *= 2;
+        unsigned char* data = realloc(writer->data, capacity);
+        if (!data)
+        {
+            writer->failed = true;
+            return;
+        }
+        writer->data = data;
+        writer->capacity = capacity;
+    }
+    memcpy(writer->data + writer->size, bytes, count);
+    writer->size += count;
+}
+
+// LEB128: 7 bits per byte, high bit set while more bytes follow; returns the byte count
+static int EncodeVarint(unsigned char bytes[5], uint32_t value)
+{
+    int count = 0;
+    do
+    {
+        bytes[count] = (unsigned char)(value & 0x7F);
+        value >>= 7;
+        if (value) bytes[count] |= 0x80;
+        count++;
+    } while (value);
+    return count;
+}
+
+static void WriteVarint(ReplayWriter* writer, uint32_t value)
+{
+    unsigned char bytes[5];
+    WriteBytes(writer, bytes, (size_t)EncodeVarint(bytes, value));
+}
+
+// Zigzag: small negative numbers stay small (0, -1, 1, -2 -> 0, 1, 2, 3)
+static void WriteSigned(ReplayWriter* writer, int value)
+{
+    WriteVarint(writer, ((uint32_t)value << 1) ^ (uint32_t)-(int32_t)(value < 0));
+}
+
+// Record header: kind and tick difference with the previous record
+static void WriteRecord(ReplayWriter* writer, ReplayRecord record, int tick)
+{
+    WriteVarint(writer, (uint32_t)record);
+    WriteVarint(writer, (uint32_t)(tick - writer->lastTick));
+    writer->lastTick = tick;
+}
+
+// === BYTE INPUT ===
+typedef struct ReplayReader
+{
+    const unsigned char* position;   // Next byte
+    const unsigned char* end;        // End of the readable area
+    bool failed;                     // Read past the end or malformed number
+} ReplayReader;
+
+static uint32_t ReadVarint(ReplayReader* reader)
+{
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (reader->position >= reader->end) break;
+        unsigned char byte = *reader->position++;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    reader->failed = true;
+    return 0;
+}
+
+static int ReadSigned(ReplayReader* reader)
+{
+    uint32_t value = ReadVarint(reader);
+    return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+// Reads a varint that must lie in [minimum, maximum]
+static int ReadRange(ReplayReader* reader, int minimum, int maximum)
+{
+    uint32_t value = ReadVarint(reader);
+    if ((int64_t)value < minimum || (int64_t)value > maximum) reader->failed = true;
+    return reader->failed ? minimum : (int)value;
+}
+
+// === FREE LIST CHANGES ===
+// The slots whose cell differs from the list of the previous keyframe, as
+// (slot gap, cell) pairs; slots past the end of that list are all written
+static void WriteFreeListDelta(ReplayWriter* writer, const Board* board)
+{
+    if (writer->failed) return;   // No base list
+    int count = board->freeCount;
+    int changed = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (i >= writer->freeCount || writer->freeCells[i] != board->freeCells[i]) changed++;
+    }
+
+    WriteVarint(writer, (uint32_t)count);
+    WriteVarint(writer, (uint32_t)changed);
+    int previous = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (i < writer->freeCount && writer->freeCells[i] == board->freeCells[i]) continue;
+        WriteVarint(writer, (uint32_t)(i - previous));
+        WriteVarint(writer, (uint32_t)board->freeCells[i]);
+        writer->freeCells[i] = board->freeCells[i];
+        previous = i;
+    }
+    writer->freeCount = count;
+}
+
+// Applies the changes of one keyframe to the list of the previous one
+static void ReadFreeListDelta(ReplayReader* reader, int* freeCells, int* freeCount, int cellCount)
+{
+    int count = ReadRange(reader, 0, cellCount);
+    int changed = ReadRange(reader, 0, count);
+    long long slot = 0;
+    for (int i = 0; i < changed && !reader->failed; i++)
+    {
+        slot += ReadRange(reader, (i == 0) ? 0 : 1, count);
+        int cell = ReadRange(reader, 0, cellCount - 1);
+        if (slot >= count) reader->failed = true;
+        if (!reader->failed) freeCells[slot] = cell;
+    }
+    *freeCount = count;
+}
+
+// === KEYFRAME STATE ===
+// Everything the next ticks depend on: the changes to the order of the free
+// list first, so seeking can read them without the rest
+static void WriteKeyframeState(ReplayWriter* writer, const GameState* game)
+{
+    WriteFreeListDelta(writer, &game->board);
+
+    uint32_t intervalBits;
+    memcpy(&intervalBits, &game->tickInterval, sizeof(intervalBits)); // Exact float
+
+    WriteVarint(writer, (uint32_t)game->direction);
+    WriteVarint(writer, (uint32_t)game->nextDirection);
+    WriteVarint(writer, (uint32_t)game->score);
+    WriteVarint(writer, intervalBits);
+    WriteVarint(writer, (uint32_t)game->random.state);          // The stream (increment) comes from the seed
+    WriteVarint(writer, (uint32_t)(game->random.state >> 32));
+    WriteVarint(writer, (uint32_t)game->over | (uint32_t)game->won << 1);
+    WriteVarint(writer, (uint32_t)game->lastEaten);
+    WriteVarint(writer, (uint32_t)game->fruitCount);
+    for (int i = 0; i < game->fruitCount; i++)
+    {
+        WriteVarint(writer, (uint32_t)game->fruits[i].position.x);
+        WriteVarint(writer, (uint32_t)game->fruits[i].position.y);
+        WriteVarint(writer, (uint32_t)game->fruits[i].type);
+    }
+
+    WriteVarint(writer, (uint32_t)game->fenceCount);
+    for (int i = 0; i < game->fenceCount; i++)
+    {
+        WriteVarint(writer, (uint32_t)game->fencePositions[i].x);
+        WriteVarint(writer, (uint32_t)game->fencePositions[i].y);
+    }
+
+    // Head position, then each segment as a step from the previous one (one byte each)
+    const Snake* snake = &game->snake;
+    WriteVarint(writer, (uint32_t)snake->length);
+    WriteVarint(writer, (uint32_t)snake->growth);
+    WriteVarint(writer, (uint32_t)snake->landedOn);
+    Cell previous = SnakeSegment(snake, 0);
+    WriteSigned(writer, previous.x);
+    WriteSigned(writer, previous.y);
+    for (int i = 1; i < snake->length; i++)
+    {
+        Cell segment = SnakeSegment(snake, i);
+        WriteSigned(writer, segment.x - previous.x);
+        WriteSigned(writer, segment.y - previous.y);
+        previous = segment;
+    }
+}
+
+// === CHECK THE SNAKE OF A KEYFRAME ===
+// Steps between segments are checked as they are read; here every segment
+// must be a distinct tile of the board. Only the head of a finished game may
+// be off the board or on its own body (where it crashed).
+static bool ValidKeyframeSnake(const Board* board, const Snake* snake, bool over)
+{
+    unsigned char* seen = calloc((size_t)(board->columns * board->rows), 1);
+    if (!seen) return false;
+
+    bool valid = true;
+    for (int i = over ? 1 : 0; i < snake->length && valid; i++)
+    {
+        int index = BoardIndex(board, snake->cells[i]);
+        valid = index >= 0 && !seen[index];
+        if (valid) seen[index] = 1;
+    }
+    free(seen);
+    return valid;
+}
+
+// Rebuilds the game from a keyframe, given the free list of the keyframe
+// before it (or of an empty board); returns false on damaged data
+static bool ReadKeyframeState(ReplayReader* reader, GameState* game, int tick, int* freeCells, int freeCount)
+{
+    Board* board = &game->board;
+    Snake* snake = &game->snake;
+    ReadFreeListDelta(reader, freeCells, &freeCount, board->columns * board->rows);
+
+    game->direction = (Direction)ReadRange(reader, DIRECTION_UP, DIRECTION_LEFT);
+    game->nextDirection = (Direction)ReadRange(reader, DIRECTION_UP, DIRECTION_LEFT);
+    game->score = ReadRange(reader, 0, INT32_MAX);
+    uint32_t intervalBits = ReadVarint(reader);
+    memcpy(&game->tickInterval, &intervalBits, sizeof(intervalBits));
+    uint32_t stateLow = ReadVarint(reader);
+    uint32_t stateHigh = ReadVarint(reader);
+    game->random.state = (uint64_t)stateHigh << 32 | stateLow;
+    int flags = ReadRange(reader, 0, 3);
+    game->over = (flags & 1) != 0;
+    game->won = (flags & 2) != 0;
+    game->lastEaten = (FruitType)ReadRange(reader, 0, FRUIT_COUNT - 1);
+
+    // Read into the pool; they are put on the board with the rest below
+    ClearFruits(game);
+    int fruitCount = ReadRange(reader, 0, board->columns * board->rows);
+    for (int i = 0; i < fruitCount && !reader->failed; i++)
+    {
+        game->fruits[i].position.x = ReadRange(reader, 0, board->columns - 1);
+        game->fruits[i].position.y = ReadRange(reader, 0, board->rows - 1);
+        game->fruits[i].type = (FruitType)ReadRange(reader, 0, FRUIT_COUNT - 1);
+    }
+
+    game->fenceCount = ReadRange(reader, 0, MAX_FENCES);
+    for (int i = 0; i < game->fenceCount; i++)
+    {
+        game->fencePositions[i].x = ReadRange(reader, 0, board->columns - 1);
+        game->fencePositions[i].y = ReadRange(reader, 0, board->rows - 1);
+    }
+
+    snake->length = ReadRange(reader, 1, snake->capacity);
+    snake->growth = ReadRange(reader, 0, INT32_MAX);
+    snake->landedOn = (CellType)ReadRange(reader, CELL_EMPTY, CELL_FRUIT);
+    snake->headIndex = 0;
+    if (reader->failed) return false;
+    Cell cell;
+    cell.x = ReadSigned(reader);    // Two statements: initializer order is unspecified
+    cell.y = ReadSigned(reader);
+    if (cell.x < -1 || cell.x > board->columns || cell.y < -1 || cell.y > board->rows)
+        return false;               // Not even one step off the board
+    snake->cells[0] = cell;
+    for (int i = 1; i < snake->length && !reader->failed; i++)
+    {
+        int dx = ReadSigned(reader);
+        int dy = ReadSigned(reader);
+        if (!((dx == 0 && (dy == 1 || dy == -1)) || (dy == 0 && (dx == 1 || dx == -1))))
+            return false;           // Not next to the segment before
+        cell.x += dx;
+        cell.y += dy;
+        snake->cells[i] = cell;
+    }
+    if (reader->failed || !ValidKeyframeSnake(board, snake, game->over)) return false;
+
+    // Occupancy follows from the snake, the fences and the fruits...
+    ClearBoard(board);
+    for (int i = 0; i < snake->length; i++)
+        SetBoardCell(board, snake->cells[i], CELL_BODY);
+    for (int i = 0; i < game->fenceCount; i++)
+        SetBoardCell(board, game->fencePositions[i], CELL_FENCE);
+    for (int i = 0; i < fruitCount; i++)
+    {
+        Fruit fruit = game->fruits[i];   // Placing it writes the same slot
+        if (!PlaceFruit(game, fruit.position, fruit.type)) return false;
+    }
+    RestoreSnakeExits(game);
+
+    // ...but the order of the free list has to be restored as recorded
+    bool restored = SetBoardFreeOrder(board, freeCells, freeCount);
+
+    game->tickCounter = tick;
+    return restored;
+}
+
+// === START RECORDING ===
+bool BeginReplay(ReplayWriter* writer, const GameState* game, unsigned int seed, int keyframeInterval)
+{
+    // Keep the buffers of the previous game
+    writer->size = 0;
+    writer->lastTick = game->tickCounter;
+    writer->keyframeInterval = (keyframeInterval > 0) ? keyframeInterval : REPLAY_KEYFRAME_INTERVAL;
+    writer->keyframeCount = 0;
+    writer->failed = false;
+    writer->recording = true;
+    writer->finished = false;
+
+    // Keyframes store the free list as changes, starting from an empty board's
+    int cellCount = game->board.columns * game->board.rows;
+    if (writer->freeCapacity < cellCount)
+    {
+        free(writer->freeCells);
+        writer->freeCells = malloc(sizeof(int) * (size_t)cellCount);
+        writer->freeCapacity = writer->freeCells ? cellCount : 0;
+        if (!writer->freeCells) writer->failed = true;
+    }
+    for (int i = 0; i < writer->freeCapacity && i < cellCount; i++)
+        writer->freeCells[i] = i;
+    writer->freeCount = cellCount;
+
+    WriteBytes(writer, REPLAY_MAGIC, 4);
+    WriteVarint(writer, REPLAY_VERSION);
+    WriteVarint(writer, (uint32_t)game->board.columns);
+    WriteVarint(writer, (uint32_t)game->board.rows);
+    WriteVarint(writer, seed);
+    WriteVarint(writer, (uint32_t)game->fruitTarget);
+    WriteVarint(writer, (uint32_t)writer->keyframeInterval);
+    return !writer->failed;
+}
+
+// === RECORD A TURN ===
+// After a step direction == nextDirection, so a difference means the coming step turns
+void RecordReplayTurn(ReplayWriter* writer, const GameState* game)
+{
+    if (!writer->recording || game->over || game->nextDirection == game->direction) return;
+    WriteRecord(writer, REPLAY_TURN, game->tickCounter);
+    WriteVarint(writer, (uint32_t)game->nextDirection);
+}
+
+// === RECORD THE RESULT OF A STEP ===
+void RecordReplayTick(ReplayWriter* writer, const GameState* game, unsigned int events)
+{
+    if (!writer->recording) return;
+
+    events &= ~(unsigned int)EVENT_MOVED;   // Happens every tick, nothing to learn
+    if (events != EVENT_NONE)
+    {
+        WriteRecord(writer, REPLAY_EVENTS, game->tickCounter);
+        WriteVarint(writer, events);
+    }
+
+    if (game->over || game->tickCounter % writer->keyframeInterval != 0) return;
+
+    // Index entry first: the offset is where the record starts
+    if (writer->keyframeCount == writer->keyframeCapacity)
+    {
+        int capacity = writer->keyframeCapacity ? writer->keyframeCapacity * 2 : 16;
+        ReplayKeyframe* keyframes = realloc(writer->keyframes, sizeof(ReplayKeyframe) * (size_t)capacity);
+        if (!keyframes)
+        {
+            writer->failed = true;
+            return;
+        }
+        writer->keyframes = keyframes;
+        writer->keyframeCapacity = capacity;
+    }
+    writer->keyframes[writer->keyframeCount++] = (ReplayKeyframe){ game->tickCounter, writer->size };
+
+    // The state is written to the end of the buffer first to learn its size,
+    // then moved after the record header
+    WriteRecord(writer, REPLAY_KEYFRAME, game->tickCounter);
+    size_t headerEnd = writer->size;
+    WriteKeyframeState(writer, game);
+    if (writer->failed) return;
+    size_t stateSize = writer->size - headerEnd;
+
+    unsigned char sizeBytes[5];
+    size_t sizeLength = (size_t)EncodeVarint(sizeBytes, (uint32_t)stateSize);
+    WriteBytes(writer, sizeBytes, sizeLength);  // Makes room
+    if (writer->failed) return;
+    memmove(writer->data + headerEnd + sizeLength, writer->data + headerEnd, stateSize);
+    memcpy(writer->data + headerEnd, sizeBytes, sizeLength);
+}
+
+// === FINISH RECORDING ===
+bool FinishReplay(ReplayWriter* writer, const GameState* game)
+{
+    if (!writer->recording) return writer->finished && !writer->failed; // Done already, or stopped
+    WriteRecord(writer, REPLAY_END, game->tickCounter);
+
+    // Keyframe index, then its position in the last four bytes
+    uint32_t indexOffset = (uint32_t)writer->size;
+    WriteVarint(writer, (uint32_t)writer->keyframeCount);
+    int previousTick = 0;
+    size_t previousOffset = 0;
+    for (int i = 0; i < writer->keyframeCount; i++)
+    {
+        WriteVarint(writer, (uint32_t)(writer->keyframes[i].tick - previousTick));
+        WriteVarint(writer, (uint32_t)(writer->keyframes[i].offset - previousOffset));
+        previousTick = writer->keyframes[i].tick;
+        previousOffset = writer->keyframes[i].offset;
+    }
+    unsigned char trailer[TRAILER_SIZE] = {
+        (unsigned char)indexOffset, (unsigned char)(indexOffset >> 8),
+        (unsigned char)(indexOffset >> 16), (unsigned char)(indexOffset >> 24)
+    };
+    WriteBytes(writer, trailer, TRAILER_SIZE);
+
+    writer->recording = false;
+    writer->finished = true;
+    return !writer->failed;
+}
+
+// === STOP RECORDING ===
+void StopReplay(ReplayWriter* writer)
+{
+    writer->recording = false;
+}
+
+// === SAVE TO A FILE ===
+bool SaveReplay(const ReplayWriter* writer, const char* path)
+{
+    if (!writer->finished || writer->failed) return false;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(writer->data, 1, writer->size, file) == writer->size;
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+// === FREE RECORDING MEMORY ===
+void FreeReplayWriter(ReplayWriter* writer)
+{
+    free(writer->data);
+    free(writer->keyframes);
+    free(writer->freeCells);
+    *writer = (ReplayWriter){ 0 };
+}
+
+// === OPEN A REPLAY ===
+bool OpenReplay(Replay* replay, const unsigned char* data, size_t size)
+{
+    *replay = (Replay){ 0 };
+    if (size < 4 + TRAILER_SIZE || memcmp(data, REPLAY_MAGIC, 4) != 0) return false;
+
+    // Header
+    ReplayReader reader = { data + 4, data + size - TRAILER_SIZE, false };
+    if (ReadVarint(&reader) != REPLAY_VERSION) return false;
+    replay->data = data;
+    replay->size = size;
+    replay->columns = ReadRange(&reader, START_LENGTH + 2, 65535);
+    replay->rows = ReadRange(&reader, 1, 65535);
+    replay->seed = ReadVarint(&reader);
+    long long cellCount = (long long)replay->columns * replay->rows;   // Up to 65535 squared
+    replay->fruitTarget = ReadRange(&reader, 1, (cellCount > INT32_MAX) ? INT32_MAX : (int)cellCount);
+    replay->keyframeInterval = ReadRange(&reader, 1, INT32_MAX);
+    replay->recordsOffset = (size_t)(reader.position - data);
+    if (reader.failed) return false;
+
+    // Keyframe index
+    const unsigned char* trailer = data + size - TRAILER_SIZE;
+    size_t indexOffset = (size_t)trailer[0] | (size_t)trailer[1] << 8 | (size_t)trailer[2] << 16 | (size_t)trailer[3] << 24;
+    if (indexOffset < replay->recordsOffset || indexOffset > size - TRAILER_SIZE) return false;
+    reader.position = data + indexOffset;
+    int count = ReadRange(&reader, 0, (int)(size / 2));
+    if (reader.failed) return false;
+
+    replay->keyframes = malloc(sizeof(ReplayKeyframe) * (size_t)(count + 1));
+    if (!replay->keyframes) return false;
+    int tick = 0;
+    size_t offset = 0;
+    for (int i = 0; i < count && !reader.failed; i++)
+    {
+        tick += (int)ReadVarint(&reader);
+        offset += ReadVarint(&reader);
+        if (offset < replay->recordsOffset || offset >= indexOffset) reader.failed = true;
+        replay->keyframes[i] = (ReplayKeyframe){ tick, offset };
+    }
+    replay->keyframeCount = count;
+
+    // The end record closes the records: its tick is the length of the game
+    reader.position = data + replay->recordsOffset;
+    reader.end = data + indexOffset;
+    tick = 0;
+    while (!reader.failed)
+    {
+        ReplayRecord record = (ReplayRecord)ReadVarint(&reader);
+        tick += (int)ReadVarint(&reader);
+        if (record == REPLAY_END) break;
+        if (record == REPLAY_KEYFRAME)
+        {
+            size_t stateSize = ReadVarint(&reader);
+            if (stateSize > (size_t)(reader.end - reader.position)) reader.failed = true;
+            else reader.position += stateSize;
+        }
+        else if (record == REPLAY_TURN || record == REPLAY_EVENTS) ReadVarint(&reader);
+        else reader.failed = true;
+    }
+    replay->tickCount = tick;
+
+    if (reader.failed) CloseReplay(replay);
+    return !reader.failed;
+}
+
+// === SIMULATE UP TO A TICK ===
+// Steps without turning; stops early if the game ends
+static unsigned int AdvanceTo(GameState* game, int tick, unsigned int events)
+{
+    while (game->tickCounter < tick && !game->over)
+        events = GameStep(game, (GameInput){ DIRECTION_NONE });
+    return events;
+}
+
+// === SEEK ===
+bool SeekReplay(const Replay* replay, GameState* game, int tick)
+{
+    if (game->board.columns != replay->columns || game->board.rows != replay->rows) return false;
+    if (tick > replay->tickCount) tick = replay->tickCount;
+    SetFruitTarget(game, replay->fruitTarget);
+
+    // Start from the last keyframe at or before the tick, or from the seed
+    int keyframe = -1;
+    for (int i = 0; i < replay->keyframeCount && replay->keyframes[i].tick <= tick; i++)
+        keyframe = i;
+
+    ReplayReader reader = { replay->data + replay->recordsOffset, replay->data + replay->size - TRAILER_SIZE, false };
+    int recordTick = 0;
+    if (keyframe >= 0)
+    {
+        // Free list of the keyframe before: the changes of every earlier one, in turn
+        int cellCount = game->board.columns * game->board.rows;
+        int* freeCells = malloc(sizeof(int) * (size_t)cellCount);
+        if (!freeCells) return false;
+        for (int i = 0; i < cellCount; i++)
+            freeCells[i] = i;
+        int freeCount = cellCount;
+        for (int i = 0; i <= keyframe && !reader.failed; i++)
+        {
+            reader.position = replay->data + replay->keyframes[i].offset;
+            if (ReadVarint(&reader) != REPLAY_KEYFRAME) reader.failed = true;
+            ReadVarint(&reader);    // Delta from the previous record: the index has the tick
+            ReadVarint(&reader);    // State size
+            if (i < keyframe) ReadFreeListDelta(&reader, freeCells, &freeCount, cellCount);
+        }
+
+        recordTick = replay->keyframes[keyframe].tick;
+        SeedGameState(game, replay->seed);  // Stream selectors; the keyframe overwrites the state
+        bool restored = !reader.failed && ReadKeyframeState(&reader, game, recordTick, freeCells, freeCount);
+        free(freeCells);
+        if (!restored) return false;
+    }
+    else
+    {
+        SeedGameState(game, replay->seed);
+        ResetGameState(game);
+    }
+
+    // Replay the turns; recorded events must match the simulated ones
+    unsigned int events = EVENT_NONE;
+    while (game->tickCounter < tick)
+    {
+        ReplayRecord record = (ReplayRecord)ReadVarint(&reader);
+        recordTick += (int)ReadVarint(&reader);
+        if (reader.failed) return false;
+
+        if (record == REPLAY_TURN)
+        {
+            Direction turn = (Direction)ReadRange(&reader, DIRECTION_UP, DIRECTION_LEFT);
+            if (reader.failed) return false;
+            if (recordTick >= tick) break;      // The turn happens after the target
+            events = AdvanceTo(game, recordTick, events);
+            if (game->tickCounter != recordTick) return false;
+            events = GameStep(game, (GameInput){ turn });
+        }
+        else if (record == REPLAY_EVENTS)
+        {
+            unsigned int recorded = ReadVarint(&reader);
+            if (recordTick > tick) break;
+            events = AdvanceTo(game, recordTick, events);
+            if (game->tickCounter != recordTick || (events & ~(unsigned int)EVENT_MOVED) != recorded)
+                return false; // The rules changed since the game was recorded
+        }
+        else if (record == REPLAY_KEYFRAME)
+        {
+            uint32_t stateSize = ReadVarint(&reader);
+            if (stateSize > (size_t)(reader.end - reader.position)) return false;
+            reader.position += stateSize;
+        }
+        else if (record == REPLAY_END)
+        {
+            break;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    AdvanceTo(game, tick, events);     // No turn left before the target
+    return game->tickCounter == tick;
+}
+
+// === CLOSE A REPLAY ===
+void CloseReplay(Replay* replay)
+{
+    free(replay->keyframes);
+    *replay = (Replay){ 0 };
+}
+
+// === COMMAND-LINE CHECK ===
+int RunReplay(int argc, char** argv)
+{
+    const char* path = NULL;
+    int tick = -1;  // End of the game
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--tick") == 0 && i + 1 < argc) tick = atoi(argv[++i]);
+        else path = argv[i];
+    }
+    if (!path)
+    {
+        fprintf(stderr, "usage: %s --replay FILE [--tick T]\n", argv[0]);
+        return 1;
+    }
+
+    // The whole file is read: a long game is a few kilobytes
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* data = (size > 0) ? malloc((size_t)size) : NULL;
+    bool read = data && fread(data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+
+    Replay replay;
+    if (!read || !OpenReplay(&replay, data, (size_t)size))
+    {
+        fprintf(stderr, "%s is not a valid replay\n", path);
+        free(data);
+        return 1;
+    }
+    if (tick < 0 || tick > replay.tickCount) tick = replay.tickCount;
+
+    GameState game;
+    bool ok = InitGameState(&game, replay.columns, replay.rows, replay.seed) && SeekReplay(&replay, &game, tick);
+    printf("%s: %dx%d board, seed %u, %d fruits, %d ticks, %d keyframes, %ld bytes\n", path,
+        replay.columns, replay.rows, replay.seed, replay.fruitTarget, replay.tickCount, replay.keyframeCount, size);
+    if (ok)
+        printf("tick %d: score %d, length %d, fences %d%s\n", game.tickCounter, game.score,
+            game.snake.length, game.fenceCount, game.won ? ", won" : (game.over ? ", dead" : ""));
+    else
+        fprintf(stderr, "replay does not match the simulation at tick %d\n", game.tickCounter);
+
+    FreeGameState(&game);
+    CloseReplay(&replay);
+    free(data);
+    return ok ? 0 : 1;
+}
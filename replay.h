@@ -0,0 +1,125 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sim.h"
+
+// === REPLAY FORMAT ===
+// A game is its seed plus the ticks where the snake turned: everything else
+// is re-simulated. Numbers are LEB128 varints, ticks are stored as the
+// difference with the previous record:
+//
+//   "SNRP" version columns rows seed fruitTarget keyframeInterval
+//   records: TURN tick direction | EVENTS tick flags | KEYFRAME tick size state | END tick
+//   keyframe index: count, then (tick, offset) pairs, both delta coded
+//   offset of the index (4 bytes, little endian)
+//
+// A keyframe holds the full state every keyframeInterval ticks, so seeking
+// restores the nearest one and simulates forward from there. It costs about
+// two bytes per snake segment plus the fruits and fences. The order of the
+// free list (which fruit and fence spawns depend on) only changes where a
+// tile was taken or freed, so each keyframe stores the slots that changed
+// since the previous one, the first against the order of an empty board: a
+// few thousand entries per keyframe instead of one per free tile, and seeking
+// applies the keyframes' changes in turn up to the one it starts from.
+
+// === CONSTANTS ===
+#define REPLAY_VERSION 4
+#define REPLAY_KEYFRAME_INTERVAL 600   // Ticks between two keyframes (about a minute at start speed)
+#define REPLAY_FILE "last_game.snr"    // Where the game saves the last finished game
+
+// === KINDS OF RECORDS ===
+typedef enum ReplayRecord
+{
+    REPLAY_END,        // End of the game (tick of the last step)
+    REPLAY_TURN,       // The step from this tick turned in a new direction
+    REPLAY_EVENTS,     // GameEvent flags of the step that reached this tick (EVENT_MOVED left out)
+    REPLAY_KEYFRAME    // Full state after the step that reached this tick
+} ReplayRecord;
+
+// === KEYFRAME POSITION ===
+typedef struct ReplayKeyframe
+{
+    int tick;          // Tick the keyframe was taken at
+    size_t offset;     // Byte position of its record
+} ReplayKeyframe;
+
+// === REPLAY BEING RECORDED ===
+typedef struct ReplayWriter
+{
+    unsigned char* data;         // Encoded replay
+    size_t size;                 // Bytes used
+    size_t capacity;             // Bytes allocated
+    int lastTick;                // Tick of the previous record (base of the next delta)
+    int keyframeInterval;        // Ticks between two keyframes
+    ReplayKeyframe* keyframes;   // Keyframes written so far
+    int keyframeCount;           // Number of keyframes
+    int keyframeCapacity;        // Keyframes allocated
+    int* freeCells;              // Free list as of the previous keyframe (base of the next one)
+    int freeCount;               // Entries of that list
+    int freeCapacity;            // Entries allocated
+    bool failed;                 // Out of memory: the replay is incomplete
+    bool recording;              // Between BeginReplay() and FinishReplay() or StopReplay()
+    bool finished;               // FinishReplay() was called
+} ReplayWriter;
+
+// === REPLAY BEING READ ===
+typedef struct Replay
+{
+    const unsigned char* data;   // Whole file (owned by the caller)
+    size_t size;                 // File size
+    int columns;                 // Board width of the game
+    int rows;                    // Board height of the game
+    unsigned int seed;           // Seed given to SeedGameState()
+    int fruitTarget;             // Fruits kept on the board (1 = classic)
+    int keyframeInterval;        // Ticks between two keyframes
+    size_t recordsOffset;        // Position of the first record
+    int tickCount;               // Ticks played in the game
+    ReplayKeyframe* keyframes;   // Index read from the end of the file
+    int keyframeCount;           // Number of keyframes
+} Replay;
+
+// === RECORDING ===
+
+// Start recording a game that was just seeded and reset (tick 0); returns false on failure
+bool BeginReplay(ReplayWriter* writer, const GameState* game, unsigned int seed, int keyframeInterval);
+
+// Call before each GameStep(): records the turn the step will make, if any
+void RecordReplayTurn(ReplayWriter* writer, const GameState* game);
+
+// Call after each GameStep() with its events: records them and the keyframes
+void RecordReplayTick(ReplayWriter* writer, const GameState* game, unsigned int events);
+
+// Write the end record and the keyframe index; returns false if the replay is
+// incomplete or was stopped
+bool FinishReplay(ReplayWriter* writer, const GameState* game);
+
+// Stop recording without finishing: the game no longer follows from its seed
+// (a loaded state), so there is nothing to save at the end
+void StopReplay(ReplayWriter* writer);
+
+// Write a finished replay to a file
+bool SaveReplay(const ReplayWriter* writer, const char* path);
+
+// Free the recording buffers
+void FreeReplayWriter(ReplayWriter* writer);
+
+// === PLAYBACK ===
+
+// Parse the header and the keyframe index of a replay held in memory
+bool OpenReplay(Replay* replay, const unsigned char* data, size_t size);
+
+// Put a game (already initialized at the replay's board size) in the state of a tick;
+// returns false if the file is damaged or the simulation no longer matches it
+bool SeekReplay(const Replay* replay, GameState* game, int tick);
+
+// Free the keyframe index
+void CloseReplay(Replay* replay);
+
+// Command-line mode: check a replay and print the state at a tick
+//   TheSnakeman --replay FILE [--tick T]
+int RunReplay(int argc, char** argv);
+
+#endif // REPLAY_H
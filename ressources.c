@@ -1,11 +1,15 @@
 #include <raylib.h>
+#include <rlgl.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "game.h"
 #include "ressources.h"
 #include "snake.h"
 #include "food.h"
 #include "hint.h"
+#include "loader.h"
+#include "audio.h"
 
 // === SCREEN SETTINGS ===
 const int screenWidth = 960;       // Width of the game window
@@ -20,12 +24,36 @@ Color black = { 0, 0, 0, 255 };                // Black color for text
 Color semiTransparentBlack = { 0, 0, 0, 150 }; // Semi-transparent black
 
 // === TEXTURES AND FONT ===
-Texture2D headTexture;                        // Snake head texture
-Texture2D bodyTexture;                        // Snake body texture
-Texture2D legsTexture;                        // Snake tail/legs texture
-Texture2D fruitTextures[FRUIT_NUMBER];        // Array of fruit textures
-Texture2D fenceTexture;                        // Fence texture
-Font myFont;                                  // Font for on-screen text
+Texture2D spriteAtlas;                        // Every sprite and its rotations in one texture
+Rectangle spriteRects[SPRITE_NUMBER][4];      // Atlas area of each sprite at 0/90/180/270 degrees
+const int fontSizes[FONT_SIZE_COUNT] = { 32, 44, 50, 64, 80 }; // Every size the screens draw text at
+Font fonts[FONT_SIZE_COUNT];                  // One glyph atlas per size: text is never scaled
+
+// === CACHED BACKGROUNDS ===
+RenderTexture2D backgroundTexture;            // HUD bar + checkerboard, drawn once
+RenderTexture2D overlayTexture;               // Same with the dark overlay of the menus
+
+// === CACHED TEXT ===
+// Text drawn once into a texture with what is behind it, and drawn again only
+// when one of the values it shows changes; in between it is a single quad
+typedef struct TextLayer
+{
+    RenderTexture2D texture;  // Opaque: background and text
+    int key[4];               // Values the texture shows (screen, scores)
+    bool valid;               // The texture matches key
+} TextLayer;
+
+static TextLayer hudLayer;    // HUD bar of the gameplay screen
+static TextLayer menuLayer;   // Title, pause or ending screen, whichever was shown last
+
+// === RETAINED BOARD ===
+// The gameplay board kept between frames: only the tiles whose sprite changed
+// are painted again, and a frame without a tick reuses it as it is
+static RenderTexture2D boardLayer;  // Screen sized, the rows under the HUD bar are used
+static DrawDiff boardDiff;          // What boardLayer shows, tile by tile
+
+// === BOARD CAMERA ===
+Camera2D boardCamera = { { 0, 0 }, { 0, 0 }, 0.0f, 1.0f }; // Board world to screen, follows the head
 
 // === AUDIO ===
 Music gameMusic[MUSIC_NUMBER];               // Array of game music tracks
@@ -36,98 +64,74 @@ int playMusicPause = -1;                     // Index of currently playing pause
 int playMusicGameplay = -1;                  // Index of currently playing gameplay music (-1 if none)
 int playMusicEnding = -1;                    // Index of currently playing ending music (-1 if none)
 
-// === HEAD SETTINGS ===
-int headAngle = 270;                         // Rotation angle of the snake head
-Vector2 origin = { 0 };                       // Rotation origin of the head
-Rectangle sourceRec = { 0 };                  // Source rectangle for head texture
-
-// === AUDIO SETUP FUNCTION ===
-void SetAudio(void)
+// === DRAW A SPRITE FROM THE ATLAS ===
+// angle is a multiple of 90 degrees, clockwise; nothing is rotated at draw time
+void DrawSprite(SpriteId sprite, int angle, Rectangle dest)
 {
-    // --- Load Music Tracks ---
-    gameMusic[0] = LoadMusicStream("Assets/Tic_Tac.mp3");              // Title screen
-    gameMusic[1] = LoadMusicStream("Assets/pause_music.mp3");          // Pause screen
-    gameMusic[2] = LoadMusicStream("Assets/Hard_Rock.mp3");            // Gameplay track 1
-    gameMusic[3] = LoadMusicStream("Assets/Jay_in_the_elevator.mp3");  // Gameplay track 2
-    gameMusic[4] = LoadMusicStream("Assets/bs_loosing_theme.mp3");     // Ending track 1
-    gameMusic[5] = LoadMusicStream("Assets/bs_loosing_theme_slowed.mp3"); // Ending track 2
+    int rotation = ((angle / 90) % 4 + 4) % 4;
+    DrawTexturePro(spriteAtlas, spriteRects[sprite][rotation], dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
 
-    // Set volume for all music tracks
-    for (int i = 0; i < MUSIC_NUMBER; i++)
-    {
-        SetMusicVolume(gameMusic[i], 1.0f);
-    }
+// === FOLLOW THE HEAD ===
+// The view is moved by whole tiles: the head stays in the middle of it, but
+// the view never goes past the edges of the board. A board smaller than the
+// window stays in its top-left corner.
+void UpdateBoardCamera(const GameState* state)
+{
+    int viewColumns = screenWidth / tileSize;
+    int viewRows = (screenHeight - whiteHeight) / tileSize;
+    Cell head = SnakeSegment(&state->snake, 0);
+
+    int x = head.x - viewColumns / 2;
+    int y = head.y - viewRows / 2;
+    if (x > state->board.columns - viewColumns) x = state->board.columns - viewColumns;
+    if (y > state->board.rows - viewRows) y = state->board.rows - viewRows;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+
+    boardCamera.offset = (Vector2){ 0, (float)whiteHeight };
+    boardCamera.target = CellToWorld((Cell){ x, y });
+}
 
-    // --- Load Sound Effects ---
-    gameSound[0] = LoadSound("Assets/eating_sound.wav");       // Normal eating sound
-    gameSound[1] = LoadSound("Assets/eating_bonus_sound.wav"); // Bonus eating sound
+// === VISIBLE TILES ===
+// One more column and row on the top-left: fruits and fences drawn at their
+// own size may reach into the view from there
+BoardView GetBoardView(void)
+{
+    BoardView view;
+    view.x = (int)boardCamera.target.x / tileSize - 1;
+    view.y = (int)boardCamera.target.y / tileSize - 1;
+    view.columns = screenWidth / tileSize + 1;
+    view.rows = (screenHeight - whiteHeight) / tileSize + 1;
+    return view;
+}
 
-    // Set volume for all sound effects
-    for (int i = 0; i < SOUND_NUMBER; i++)
+// === DRAW ONE BOARD SPRITE ===
+// In board world coordinates, under the board camera
+static void DrawBoardItem(const DrawItem* item)
+{
+    Vector2 position = CellToWorld(item->cell);
+    Rectangle dest = { position.x, position.y, (float)tileSize, (float)tileSize };
+    if (item->sprite >= SPRITE_FRUIT)
     {
-        SetSoundVolume(gameSound[i], 1.0f);
+        // Fruits and fences keep their natural size
+        dest.width = spriteRects[item->sprite][0].width;
+        dest.height = spriteRects[item->sprite][0].height;
     }
+    DrawSprite(item->sprite, item->angle, dest);
 }
 
-// === TEXTURE AND FONT SETUP FUNCTION ===
-void SetGameTextures(void)
-{
-    Image image; // Temporary image used to load textures
-
-    // --- Head Texture ---
-    image = LoadImage("Assets/head.png");                 // Load image from file
-    ImageColorReplace(&image, WHITE, BLANK);             // Replace white with transparency
-    headTexture = LoadTextureFromImage(image);           // Create texture from image
-    UnloadImage(image);                                  // Free temporary image
-    origin = (Vector2){ (float)headTexture.width / 2.0f, (float)headTexture.height / 2.0f }; // Set rotation origin
-    sourceRec = (Rectangle){ 0, 0, (float)headTexture.width, (float)headTexture.height };   // Full source rectangle
-
-    // --- Body Texture ---
-    image = LoadImage("Assets/body.png");
-    ImageColorReplace(&image, WHITE, BLANK);
-    bodyTexture = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    // --- Tail/Legs Texture ---
-    image = LoadImage("Assets/legs.png");
-    ImageColorReplace(&image, WHITE, BLANK);
-    legsTexture = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    // --- Fruit Textures ---
-    image = LoadImage("Assets/fruit.png");       // Normal fruit
-    ImageColorReplace(&image, WHITE, BLANK);
-    fruitTextures[0] = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    image = LoadImage("Assets/red_fruit.png");   // Red fruit
-    ImageColorReplace(&image, WHITE, BLANK);
-    fruitTextures[1] = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    image = LoadImage("Assets/blue_fruit.png");  // Blue fruit
-    ImageColorReplace(&image, WHITE, BLANK);
-    fruitTextures[2] = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    image = LoadImage("Assets/orange_fruit.png"); // Orange fruit
-    ImageColorReplace(&image, WHITE, BLANK);
-    fruitTextures[3] = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    image = LoadImage("Assets/purple_fruit.png"); // Purple fruit
-    ImageColorReplace(&image, WHITE, BLANK);
-    fruitTextures[4] = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    // --- Fence Texture ---
-    image = LoadImage("Assets/fence.png");
-    ImageColorReplace(&image, WHITE, BLANK);
-    fenceTexture = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    // --- Font ---
-    myFont = LoadFont("Assets/stickman.ttf");
+// === DRAW THE BOARD SPRITES ===
+// The list is built headlessly by BuildDrawList(); this only places it on
+// screen through the camera, clipped so nothing covers the HUD bar
+void DrawBoardSprites(const DrawList* list)
+{
+    BeginMode2D(boardCamera);
+    BeginScissorMode(0, whiteHeight, screenWidth, screenHeight - whiteHeight);
+    for (int i = 0; i < list->count; i++)
+        DrawBoardItem(&list->items[i]);
+    EndScissorMode();
+    EndMode2D();
 }
 
 // === DRAW GREEN CHECKERBOARD TILES ===
@@ -148,77 +152,289 @@ void DrawGreenTiles(int screenHeightParam, int screenWidthParam, int tileSizePar
     }
 }
 
+// === RENDER A BACKGROUND INTO A TEXTURE ===
+// The overlay colour is blended into every colour beforehand so the texture stays opaque.
+// One extra column lets the checkerboard be shifted by a tile when the camera moves.
+static void RenderBackground(RenderTexture2D target, Color overlay)
+{
+    BeginTextureMode(target);
+    ClearBackground(ColorAlphaBlend(RAYWHITE, overlay, WHITE)); // HUD bar
+    DrawGreenTiles(screenHeight, screenWidth + tileSize, tileSize,
+        ColorAlphaBlend(lightGreen, overlay, WHITE), ColorAlphaBlend(darkGreen, overlay, WHITE));
+    EndTextureMode();
+}
+
+// === BUILD THE CACHED BACKGROUNDS ===
+// Called once the window exists, and again if it is resized
+void LoadBackgrounds(void)
+{
+    UnloadBackgrounds();
+    backgroundTexture = LoadRenderTexture(screenWidth + tileSize, screenHeight);
+    overlayTexture = LoadRenderTexture(screenWidth + tileSize, screenHeight);
+
+    RenderBackground(backgroundTexture, BLANK);                // Gameplay
+    RenderBackground(overlayTexture, semiTransparentBlack);    // Title, pause and ending
+
+    hudLayer = (TextLayer){ .texture = LoadRenderTexture(screenWidth, whiteHeight) };    // Text drawn on first use
+    menuLayer = (TextLayer){ .texture = LoadRenderTexture(screenWidth, screenHeight) };
+    boardLayer = LoadRenderTexture(screenWidth, screenHeight);    // Painted by the next UpdateBoardLayer()
+    BoardView view = GetBoardView();
+    InitDrawDiff(&boardDiff, view.columns, view.rows);  // Without it the whole board is painted every frame
+}
+
+// === FREE THE CACHED BACKGROUNDS ===
+void UnloadBackgrounds(void)
+{
+    if (backgroundTexture.id != 0) UnloadRenderTexture(backgroundTexture);
+    if (overlayTexture.id != 0) UnloadRenderTexture(overlayTexture);
+    if (hudLayer.texture.id != 0) UnloadRenderTexture(hudLayer.texture);
+    if (menuLayer.texture.id != 0) UnloadRenderTexture(menuLayer.texture);
+    if (boardLayer.id != 0) UnloadRenderTexture(boardLayer);
+    FreeDrawDiff(&boardDiff);
+    backgroundTexture = (RenderTexture2D){ 0 };
+    overlayTexture = (RenderTexture2D){ 0 };
+    hudLayer = (TextLayer){ 0 };
+    menuLayer = (TextLayer){ 0 };
+    boardLayer = (RenderTexture2D){ 0 };
+}
+
+// === DRAW A CACHED BACKGROUND ===
+// Render textures are stored upside down: flip the source rectangle.
+// shift starts the window one tile into the texture, which swaps the colours
+// of the checkerboard.
+static void DrawCachedBackground(RenderTexture2D cached, bool shift)
+{
+    Rectangle source = { shift ? (float)tileSize : 0.0f, 0, (float)screenWidth, -(float)cached.texture.height };
+    DrawTextureRec(cached.texture, source, (Vector2){ 0, 0 }, WHITE);
+}
+
+// Gameplay background in one draw call, matching the tiles under the camera.
+// Past the edges of a board smaller than the window the grass is darkened.
+void DrawBackground(void)
+{
+    int x = (int)boardCamera.target.x / tileSize;
+    int y = (int)boardCamera.target.y / tileSize;
+    DrawCachedBackground(backgroundTexture, (x + y) % 2 != 0);
+
+    int boardRight = game.board.columns * tileSize - (int)boardCamera.target.x;
+    int boardBottom = whiteHeight + game.board.rows * tileSize - (int)boardCamera.target.y;
+    if (boardRight < screenWidth)
+        DrawRectangle(boardRight, whiteHeight, screenWidth - boardRight, screenHeight - whiteHeight, semiTransparentBlack);
+    if (boardBottom < screenHeight)
+        DrawRectangle(0, boardBottom, boardRight < screenWidth ? boardRight : screenWidth, screenHeight - boardBottom, semiTransparentBlack);
+}
+
+// Darkened background of the title, pause and ending screens in one draw call
+void DrawOverlayBackground(void)
+{
+    DrawCachedBackground(overlayTexture, false);
+}
+
+// === COPY AN OPAQUE LAYER ===
+// Layers are opaque: they are copied as they are, without blending the edges
+// of glyphs and sprites twice. Only the rows from top down are copied; render
+// textures are stored upside down, so those start at the first row of the texture
+static void DrawOpaqueLayer(RenderTexture2D layer, int top)
+{
+    Texture2D texture = layer.texture;
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    DrawTextureRec(texture, (Rectangle){ 0, 0, (float)texture.width, -(float)(texture.height - top) }, (Vector2){ 0, (float)top }, WHITE);
+    EndBlendMode();
+}
+
+// === REPAINT THE RETAINED BOARD ===
+// A dirty tile gets its grass back, then every sprite reaching into it, all
+// clipped to the tile so the sprites around it are not drawn over twice
+void UpdateBoardLayer(const DrawList* list, BoardView view)
+{
+    int dirtyCount = DiffDrawList(&boardDiff, list, view);
+    BeginTextureMode(boardLayer);
+    if (dirtyCount < 0)
+    {
+        DrawBackground();            // Whole view: first frame, new game or the camera moved
+        DrawBoardSprites(list);
+    }
+    for (int i = 0; i < dirtyCount; i++)
+    {
+        Vector2 corner = GetWorldToScreen2D(CellToWorld(boardDiff.dirty[i]), boardCamera);
+        int left = (int)corner.x;
+        int top = (int)corner.y;
+        int right = left + tileSize;
+        int bottom = top + tileSize;
+        if (left < 0) left = 0;
+        if (top < whiteHeight) top = whiteHeight;   // Never over the HUD bar
+        if (right > screenWidth) right = screenWidth;
+        if (bottom > screenHeight) bottom = screenHeight;
+        if (left >= right || top >= bottom) continue;
+
+        DrawItem items[4];
+        int count = TileSprites(&boardDiff, boardDiff.dirty[i], items);
+        BeginScissorMode(left, top, right - left, bottom - top);
+        DrawBackground();            // Only this tile of it
+        BeginMode2D(boardCamera);
+        for (int j = 0; j < count; j++)
+            DrawBoardItem(&items[j]);
+        EndMode2D();
+        EndScissorMode();
+    }
+    EndTextureMode();
+}
+
+// The next UpdateBoardLayer() paints the whole view
+void InvalidateBoardLayer(void)
+{
+    InvalidateDrawDiff(&boardDiff);
+}
+
+bool BoardLayerStale(void)
+{
+    return !boardDiff.valid;
+}
+
+// The board under the HUD bar in one quad
+void DrawBoardLayer(void)
+{
+    DrawOpaqueLayer(boardLayer, whiteHeight);
+}
+
+// === DRAW TEXT AT A BAKED SIZE ===
+// The font of that exact size draws its glyphs 1:1 (the default font, used
+// when the file is missing, is scaled as before)
+static void DrawLabel(const char* text, float x, float y, int size, Color color)
+{
+    Font font = fonts[0];
+    for (int i = 0; i < FONT_SIZE_COUNT; i++)
+    {
+        if (fontSizes[i] == size) font = fonts[i];
+    }
+    DrawTextEx(font, text, (Vector2){ x, y }, (float)size, 2, color);
+}
+
+// === CACHED TEXT LAYERS ===
+// Returns true if the layer shows other values: it is then redrawn by the caller
+static bool TextLayerStale(TextLayer* layer, int a, int b, int c, int d)
+{
+    int key[4] = { a, b, c, d };
+    if (layer->valid && memcmp(layer->key, key, sizeof(key)) == 0) return false;
+    memcpy(layer->key, key, sizeof(key));
+    layer->valid = true;
+    return true;
+}
+
+static void DrawTextLayer(const TextLayer* layer)
+{
+    DrawOpaqueLayer(layer->texture, 0);
+}
+
 // === DRAW TITLE SCREEN TEXT ===
 void DrawTitleText(void)
 {
-    DrawTextEx(myFont, "Press ENTER", (Vector2) { 300, 515 }, 64, 2, lightGreen);      // Instruction
-    DrawTextEx(myFont, "Pause = P", (Vector2) { 10, 100 }, 32, 2, lightGreen);        // Pause info
-    DrawTextEx(myFont, "THE SNAKEMAN", (Vector2) { 235, 190 }, 80, 2, RAYWHITE);      // Game title
-    DrawTextEx(myFont, "Press ESC to quit", (Vector2) { 365, 600 }, 32, 2, lightGreen); // Quit instruction
+    if (TextLayerStale(&menuLayer, TITLE, 0, 0, 0))
+    {
+        BeginTextureMode(menuLayer.texture);
+        DrawCachedBackground(overlayTexture, false);
+        DrawLabel("Press ENTER", 300, 515, 64, lightGreen);      // Instruction
+        DrawLabel("Pause = P", 10, 100, 32, lightGreen);        // Pause info
+        DrawLabel("Autopilot = A", 10, 140, 32, lightGreen);    // Autopilot info
+        DrawLabel("THE SNAKEMAN", 235, 190, 80, RAYWHITE);      // Game title
+        DrawLabel("Press ESC to quit", 365, 600, 32, lightGreen); // Quit instruction
+        EndTextureMode();
+    }
+    DrawTextLayer(&menuLayer);
 }
 
 // === DRAW GAMEPLAY TEXT ===
+// Redrawn when a score changes, not every frame
 void DrawGameplayText(void)
 {
-    DrawTextEx(myFont, TextFormat("Score : %i", score), (Vector2) { 15, 15 }, 44, 2, black);          // Current score
-    DrawTextEx(myFont, TextFormat("High Score : %i", highScore), (Vector2) { 665, 15 }, 44, 2, black); // High score
-    DrawTextEx(myFont, TextFormat("Last Score : %i", lastScore), (Vector2) { 300, 15 }, 44, 2, black); // Last score
+    if (TextLayerStale(&hudLayer, game.score, highScore, lastScore, 0))
+    {
+        BeginTextureMode(hudLayer.texture);
+        ClearBackground(RAYWHITE); // HUD bar
+        DrawLabel(TextFormat("Score : %i", game.score), 15, 15, 44, black);          // Current score
+        DrawLabel(TextFormat("High Score : %i", highScore), 665, 15, 44, black); // High score
+        DrawLabel(TextFormat("Last Score : %i", lastScore), 300, 15, 44, black); // Last score
+        EndTextureMode();
+    }
+    DrawTextLayer(&hudLayer);
 }
 
 // === DRAW PAUSE SCREEN TEXT ===
 void DrawPauseText(void)
 {
-    DrawTextEx(myFont, TextFormat("Score : %i", score), (Vector2) { 15, 15 }, 44, 2, RAYWHITE);
-    DrawTextEx(myFont, TextFormat("High Score : %i", highScore), (Vector2) { 665, 15 }, 44, 2, RAYWHITE);
-    DrawTextEx(myFont, TextFormat("Last Score : %i", lastScore), (Vector2) { 300, 15 }, 44, 2, RAYWHITE);
-    DrawTextEx(myFont, "Press ENTER to continue", (Vector2) { 160, 515 }, 64, 2, lightGreen);
-    DrawTextEx(myFont, "Press ESC to quit", (Vector2) { 365, 600 }, 32, 2, lightGreen);
+    if (TextLayerStale(&menuLayer, PAUSE, game.score, highScore, lastScore))
+    {
+        BeginTextureMode(menuLayer.texture);
+        DrawCachedBackground(overlayTexture, false);
+        DrawLabel(TextFormat("Score : %i", game.score), 15, 15, 44, RAYWHITE);
+        DrawLabel(TextFormat("High Score : %i", highScore), 665, 15, 44, RAYWHITE);
+        DrawLabel(TextFormat("Last Score : %i", lastScore), 300, 15, 44, RAYWHITE);
+        DrawLabel("Press ENTER to continue", 160, 515, 64, lightGreen);
+        DrawLabel("Press ESC to quit", 365, 600, 32, lightGreen);
+        EndTextureMode();
+    }
+    DrawTextLayer(&menuLayer);
 }
 
 // === DRAW ENDING SCREEN TEXT ===
 void DrawEndingText(void)
 {
-    DrawTextEx(myFont, "Sorry you lost", (Vector2) { 270, 190 }, 80, 2, RAYWHITE);              // Losing message
-    DrawTextEx(myFont, "Press ENTER to retry", (Vector2) { 195, 515 }, 64, 2, lightGreen);      // Retry instruction
-    DrawTextEx(myFont, TextFormat("Your score was %i", score), (Vector2) { 305, 335 }, 50, 2, RAYWHITE); // Display final score
-    DrawTextEx(myFont, TextFormat("High Score : %i", highScore), (Vector2) { 335, 400 }, 50, 2, RAYWHITE); // High score
-    DrawTextEx(myFont, "Press ESC to quit", (Vector2) { 365, 600 }, 32, 2, lightGreen);        // Quit instruction
+    if (TextLayerStale(&menuLayer, ENDING, game.won, game.score, highScore))
+    {
+        BeginTextureMode(menuLayer.texture);
+        DrawCachedBackground(overlayTexture, false);
+        if (game.won)
+            DrawLabel("You filled the board!", 150, 190, 80, RAYWHITE);   // Winning message
+        else
+            DrawLabel("Sorry you lost", 270, 190, 80, RAYWHITE);          // Losing message
+        DrawLabel("Press ENTER to retry", 195, 515, 64, lightGreen);      // Retry instruction
+        DrawLabel(TextFormat("Your score was %i", game.score), 305, 335, 50, RAYWHITE); // Display final score
+        DrawLabel(TextFormat("High Score : %i", highScore), 335, 400, 50, RAYWHITE); // High score
+        DrawLabel("Press ESC to quit", 365, 600, 32, lightGreen);        // Quit instruction
+        EndTextureMode();
+    }
+    DrawTextLayer(&menuLayer);
 }
 
 // === AUDIO PLAYBACK FUNCTIONS ===
+// Only commands to the music service: the streams are refilled on its thread
 void PlayTitleAudio(void)
 {
     if (firstFrameTitle) // First frame of the title screen
     {
-        gameMusic[0].looping = true;       // Loop title music
-        PlayMusicStream(gameMusic[0]);     // Play title music
+        SendAudioCommand(AUDIO_CROSSFADE, 0, AUDIO_FADE_TIME); // Title music, the last ending fades out
         firstFrameTitle = false;           // Mark as played
     }
-    UpdateMusicStream(gameMusic[0]);       // Update music stream
+    UpdateAudioService();                  // Refill the streams if there is no service thread
 }
 
 void PlayGameplayAudio(void)
 {
     if (playMusicGameplay == -1) // If gameplay music hasn't started yet
     {
-        StopMusicStream(gameMusic[0]);                // Stop title music
-        playMusicGameplay = GetRandomValue(2, 3);    // Randomly pick gameplay track
-        gameMusic[playMusicGameplay].looping = true; // Loop selected music
-        PlayMusicStream(gameMusic[playMusicGameplay]);
+        playMusicGameplay = 2 + RngRange(&game.cosmetic, 2); // Randomly pick gameplay track
+        SendAudioCommand(AUDIO_CROSSFADE, playMusicGameplay, AUDIO_FADE_TIME); // From the title music
     }
-    UpdateMusicStream(gameMusic[playMusicGameplay]); // Update music
+    UpdateAudioService();
 }
 
 void PlayPauseAudio(void)
 {
     if (playMusicPause == -1) // If pause music hasn't started
     {
-        PauseMusicStream(gameMusic[playMusicGameplay]); // Pause gameplay music
-        playMusicPause = 1;                             // Index of pause music
-        gameMusic[playMusicPause].looping = true;       // Loop pause music
-        PlayMusicStream(gameMusic[playMusicPause]);     // Play pause music
+        SendAudioCommand(AUDIO_PAUSE, playMusicGameplay, 0.0f); // Pause gameplay music
+        playMusicPause = 1;                                     // Index of pause music
+        SendAudioCommand(AUDIO_PLAY, playMusicPause, 0.0f);     // Play pause music
     }
-    UpdateMusicStream(gameMusic[playMusicPause]);
+    UpdateAudioService();
+}
+
+void ResumeGameplayAudio(void)
+{
+    SendAudioCommand(AUDIO_STOP, playMusicPause, 0.0f);      // Stop pause music
+    playMusicPause = -1;
+    SendAudioCommand(AUDIO_RESUME, playMusicGameplay, 0.0f); // Gameplay music where it was
 }
 
 void PlayEndingAudio(void)
@@ -226,24 +442,23 @@ void PlayEndingAudio(void)
     if (playMusicEnding == -1) // If ending music hasn't started
     {
         StopSound(gameSound[0]);                          // Stop any sound effects
-        StopMusicStream(gameMusic[playMusicGameplay]);   // Stop gameplay music
-        playMusicEnding = GetRandomValue(4, 5);          // Randomly pick ending music
-        gameMusic[playMusicEnding].looping = true;       // Loop ending music
-        PlayMusicStream(gameMusic[playMusicEnding]);     // Play ending music
+        playMusicEnding = 4 + RngRange(&game.cosmetic, 2); // Randomly pick ending music
+        SendAudioCommand(AUDIO_CROSSFADE, playMusicEnding, AUDIO_FADE_TIME); // Gameplay music fades out
     }
-    UpdateMusicStream(gameMusic[playMusicEnding]);
+    UpdateAudioService();
 }
 
 // === LOAD ALL GAME RESOURCES ===
 void LoadGameRessources(void)
 {
-    SetAudio();        // Load all sounds and music
-    SetGameTextures(); // Load all textures and font
+    StartAssetLoading(); // Decode fonts, sprites and audio on worker threads
+    LoadBackgrounds();   // Render the static backgrounds once (needs no files)
 }
 
 // === FREE AUDIO RESOURCES ===
 void FreeMusic(void)
 {
+    StopAudioService();   // Nothing plays the streams anymore
     // Unload all music streams
     for (int i = 0; i < MUSIC_NUMBER; i++)
     {
@@ -8,11 +8,14 @@
 #include "snake.h"
 #include "food.h"
 #include "hint.h"
+#include "drawlist.h"   // Sprite ids and the board draw list
 
 // === CONSTANTS ===
 #define FRUIT_NUMBER 5     // Number of fruit types
 #define SOUND_NUMBER 2     // Number of sound effects
 #define MUSIC_NUMBER 6     // Number of music tracks
+#define ATLAS_PADDING 2    // Transparent pixels between two sprites of the atlas
+#define FONT_SIZE_COUNT 5  // Text sizes in use, each with its own glyph atlas
 
 // === SCREEN SETTINGS ===
 extern const int screenWidth;   // Game window width
@@ -37,42 +40,74 @@ extern Music gameMusic[6]; // Array of music tracks
 extern Sound gameSound[2]; // Array of sound effects
 
 // === TEXTURES AND FONT ===
-extern Texture2D headTexture;                        // Snake head texture
-extern Texture2D bodyTexture;                        // Snake body texture
-extern Texture2D legsTexture;                        // Snake tail/legs texture
-extern Texture2D fruitTextures[FRUIT_NUMBER];        // Array of fruit textures
-extern Texture2D fenceTexture;                       // Fence texture
-extern Font myFont;                                  // Font used for on-screen text
-
-// === HEAD SETTINGS ===
-extern int headAngle;             // Rotation angle of the snake head
-extern Vector2 origin;            // Rotation origin of the head
-extern Rectangle sourceRec;       // Source rectangle for head texture
+extern Texture2D spriteAtlas;                        // Every sprite and its rotations
+extern Rectangle spriteRects[SPRITE_NUMBER][4];      // Atlas area of each sprite at 0/90/180/270 degrees
+extern const int fontSizes[FONT_SIZE_COUNT];         // Pixel size of each font, smallest first
+extern Font fonts[FONT_SIZE_COUNT];                  // On-screen font baked at each of those sizes
+
+// === CACHED BACKGROUNDS ===
+extern RenderTexture2D backgroundTexture;            // HUD bar + checkerboard
+extern RenderTexture2D overlayTexture;               // Same with the dark menu overlay
+
+// === BOARD CAMERA ===
+extern Camera2D boardCamera;                         // Board world to screen, follows the head
 
 // === FUNCTIONS ===
 
-// Load all textures, fonts, sounds, and music
+// Start loading textures, fonts, sounds, and music in the background
 void LoadGameRessources(void);
 
-// Initialize audio resources (load and set volume)
-void SetAudio(void);
+// Draw a sprite from the atlas, pre-rotated by a multiple of 90 degrees
+void DrawSprite(SpriteId sprite, int angle, Rectangle dest);
+
+// Move the board camera so the view follows the head of the snake
+void UpdateBoardCamera(const GameState* state);
+
+// Returns the tiles under the board camera (plus a margin for oversized sprites)
+BoardView GetBoardView(void);
 
-// Initialize textures and font resources
-void SetGameTextures(void);
+// Draw the sprites of a board draw list through the board camera
+// (snake on whole tiles, fruit and fences at their own size)
+void DrawBoardSprites(const DrawList* list);
 
 // Draw the green checkerboard background tiles
 void DrawGreenTiles(int screenHeight, int screenWidth, int tileSize, Color lightGreen, Color darkGreen);
 
-// Draw title screen text
+// Render the gameplay and menu backgrounds into textures (after the window is created)
+void LoadBackgrounds(void);
+
+// Free the cached background and text textures
+void UnloadBackgrounds(void);
+
+// Draw the cached gameplay background (HUD bar + checkerboard under the board camera)
+void DrawBackground(void);
+
+// Draw the cached darkened background used behind menu text
+void DrawOverlayBackground(void);
+
+// Bring the retained board up to date with a draw list of the view under the
+// board camera: only the tiles that changed since the last call are repainted
+void UpdateBoardLayer(const DrawList* list, BoardView view);
+
+// Make the next UpdateBoardLayer() repaint the whole view (new game, loaded state)
+void InvalidateBoardLayer(void);
+
+// Returns true if the retained board must be brought up to date even without a tick
+bool BoardLayerStale(void);
+
+// Draw the retained board under the HUD bar
+void DrawBoardLayer(void);
+
+// Draw the title screen: darkened background and text (cached)
 void DrawTitleText(void);
 
-// Draw gameplay screen text (score, high score, etc.)
+// Draw the HUD bar with the score, high score and last score (cached until one changes)
 void DrawGameplayText(void);
 
-// Draw pause screen text
+// Draw the pause screen: darkened background and text (cached)
 void DrawPauseText(void);
 
-// Draw ending screen text
+// Draw the ending screen: darkened background and text (cached)
 void DrawEndingText(void);
 
 // Play title screen audio
@@ -84,6 +119,9 @@ void PlayGameplayAudio(void);
 // Play pause screen audio
 void PlayPauseAudio(void);
 
+// Stop the pause music and resume the gameplay music
+void ResumeGameplayAudio(void);
+
 // Play ending screen audio
 void PlayEndingAudio(void);
 
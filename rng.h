@@ -0,0 +1,58 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// === SEEDED RANDOM NUMBER STREAMS ===
+// PCG32 (XSH RR): 64-bit state, 32-bit output, and an odd increment that
+// selects one of 2^63 independent streams. Each game owns its generators, so
+// the same seed gives bit-identical games on any thread, and drawing from one
+// stream (music picks) never shifts the numbers of another (fruit, fences).
+// The functions are inline: the simulation calls them on every fruit.
+
+// === STREAMS ===
+#define RNG_STREAM_GAMEPLAY 1u     // Fruit position and type, fence placement
+#define RNG_STREAM_COSMETIC 2u     // Choices that never change the rules (music tracks)
+#define RNG_STREAM_CONTROLLER 3u   // Bot decisions
+#define RNG_STREAM_NETWORK 4u      // Simulated packet loss and latency
+
+// === GENERATOR STATE ===
+typedef struct Rng
+{
+    uint64_t state;        // Advances on every draw
+    uint64_t increment;    // Stream selector, always odd
+} Rng;
+
+// Returns the next 32 random bits
+static inline uint32_t NextRng(Rng* rng)
+{
+    uint64_t old = rng->state;
+    rng->state = old * 6364136223846793005u + rng->increment;
+    uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rotation = (uint32_t)(old >> 59);
+    return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+}
+
+// Returns a value in [0, count) with a multiply instead of a division
+static inline int RngRange(Rng* rng, int count)
+{
+    return (int)(((uint64_t)NextRng(rng) * (uint32_t)count) >> 32);
+}
+
+// Starts a stream; consecutive seeds give unrelated sequences
+static inline void SeedRng(Rng* rng, uint64_t seed, uint64_t stream)
+{
+    // SplitMix64 spreads the seed over the whole state
+    uint64_t z = seed + 0x9e3779b97f4a7c15u;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    z ^= z >> 31;
+
+    rng->state = 0;
+    rng->increment = (stream << 1) | 1u;
+    NextRng(rng);
+    rng->state += z;
+    NextRng(rng);
+}
+
+#endif // RNG_H
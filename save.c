@@ -0,0 +1,323 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "save.h"
+#include "board.h"
+
+// === MAPPED SAVE ===
+typedef struct SaveMapping
+{
+    const unsigned char* base;   // Start of the mapping (NULL when closed)
+    size_t size;                 // Size of the file
+    void* handle;                // Platform mapping handle
+} SaveMapping;
+
+// === MAP THE FILE ===
+// Same as the asset pack: the pages are read on first touch, by the memcpy
+static bool MapSave(SaveMapping* save, const char* path)
+{
+    *save = (SaveMapping){ 0 };
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file); // The mapping keeps the file open
+    if (mapping == NULL) return false;
+
+    save->base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (save->base == NULL)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    save->size = (size_t)size.QuadPart;
+    save->handle = mapping;
+    return true;
+#else
+    int file = open(path, O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat info;
+    void* base = MAP_FAILED;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // The mapping keeps the file open
+    if (base == MAP_FAILED) return false;
+
+    save->base = base;
+    save->size = (size_t)info.st_size;
+    return true;
+#endif
+}
+
+// === UNMAP THE FILE ===
+static void UnmapSave(SaveMapping* save)
+{
+    if (save->base != NULL)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(save->base);
+        CloseHandle(save->handle);
+#else
+        munmap((void*)save->base, save->size);
+#endif
+    }
+    *save = (SaveMapping){ 0 };
+}
+
+// === LAYOUT OF THE ARRAYS ===
+// Fills the offsets and the size of the header from its counts
+static void SetSaveLayout(SaveHeader* header)
+{
+    uint64_t cellCount = (uint64_t)header->columns * (uint64_t)header->rows;
+    uint64_t offset = sizeof(SaveHeader);
+#define PLACE(field, bytes) \
+    (offset = (offset + SAVE_ALIGNMENT - 1) / SAVE_ALIGNMENT * SAVE_ALIGNMENT, header->field = offset, offset += (bytes))
+    PLACE(cellsOffset, cellCount);
+    PLACE(freeCellsOffset, sizeof(int) * (uint64_t)header->freeCount);
+    PLACE(freeSlotOffset, sizeof(int) * cellCount);
+    PLACE(segmentsOffset, sizeof(Cell) * (uint64_t)header->length);
+    PLACE(fruitsOffset, sizeof(Fruit) * (uint64_t)header->fruitCount);
+    PLACE(fruitSlotOffset, sizeof(int) * cellCount);
+#undef PLACE
+    header->fileSize = offset;
+}
+
+// === SAVE A GAME ===
+bool SaveGameState(const GameState* game, const char* path)
+{
+    const Board* board = &game->board;
+    const Snake* snake = &game->snake;
+    size_t cellCount = (size_t)board->columns * (size_t)board->rows;
+
+    SaveHeader header = {
+        .magic = SAVE_MAGIC, .version = SAVE_VERSION, .headerSize = sizeof(SaveHeader),
+        .columns = board->columns, .rows = board->rows, .freeCount = board->freeCount,
+        .length = snake->length, .growth = snake->growth, .landedOn = snake->landedOn,
+        .direction = game->direction, .nextDirection = game->nextDirection,
+        .fruitCount = game->fruitCount, .fruitTarget = game->fruitTarget,
+        .lastEaten = game->lastEaten, .fenceCount = game->fenceCount,
+        .score = game->score, .tickCounter = game->tickCounter, .tickInterval = game->tickInterval,
+        .over = game->over, .won = game->won,
+        .random = { game->random.state, game->random.increment },
+        .cosmetic = { game->cosmetic.state, game->cosmetic.increment }
+    };
+    for (int i = 0; i < game->fenceCount; i++)
+    {
+        header.fences[i][0] = game->fencePositions[i].x;
+        header.fences[i][1] = game->fencePositions[i].y;
+    }
+    SetSaveLayout(&header);
+    if (header.fileSize > SIZE_MAX) return false;
+
+    // The image is built in memory so the file gets one write; padding stays zero
+    unsigned char* image = calloc(1, (size_t)header.fileSize);
+    if (!image) return false;
+    memcpy(image, &header, sizeof(header));
+    memcpy(image + header.cellsOffset, board->cells, cellCount);
+    memcpy(image + header.freeCellsOffset, board->freeCells, sizeof(int) * (size_t)board->freeCount);
+    memcpy(image + header.freeSlotOffset, board->freeSlot, sizeof(int) * cellCount);
+    memcpy(image + header.fruitsOffset, game->fruits, sizeof(Fruit) * (size_t)game->fruitCount);
+    memcpy(image + header.fruitSlotOffset, game->fruitSlot, sizeof(int) * cellCount);
+
+    // Head first: the part of the ring buffer up to its end, then the part that wrapped
+    int first = snake->capacity - snake->headIndex;
+    if (first > snake->length) first = snake->length;
+    memcpy(image + header.segmentsOffset, snake->cells + snake->headIndex, sizeof(Cell) * (size_t)first);
+    memcpy(image + header.segmentsOffset + sizeof(Cell) * (size_t)first, snake->cells,
+        sizeof(Cell) * (size_t)(snake->length - first));
+
+    FILE* file = fopen(path, "wb");
+    bool ok = file && fwrite(image, 1, (size_t)header.fileSize, file) == header.fileSize;
+    if (file) ok = (fclose(file) == 0) && ok;
+    free(image);
+    return ok;
+}
+
+// === CHECK THE SNAKE AND FENCES AGAINST THE BOARD ===
+// Every segment on its own body tile and every fence on its own fence tile,
+// with no other body or fence tile: a file that disagrees with itself would
+// corrupt the free list on the next step. The head of a finished game may sit
+// on anything (it ran into it), so it is left out.
+static bool MatchingBoard(const SaveHeader* header, const unsigned char* cells, const Cell* segments)
+{
+    Board bounds = { .columns = header->columns, .rows = header->rows };
+    int cellCount = header->columns * header->rows;
+    unsigned char* seen = calloc((size_t)cellCount, 1);
+    if (!seen) return false;
+
+    bool valid = true;
+    int first = header->over ? 1 : 0;
+    int head = header->over ? BoardIndex(&bounds, segments[0]) : -1;
+    for (int i = first; i < header->length && valid; i++)
+    {
+        int index = BoardIndex(&bounds, segments[i]);
+        valid = index >= 0 && cells[index] == CELL_BODY && !seen[index];
+        if (valid) seen[index] = 1;
+    }
+    for (int i = 0; i < header->fenceCount && valid; i++)
+    {
+        int index = BoardIndex(&bounds, (Cell){ header->fences[i][0], header->fences[i][1] });
+        valid = index >= 0 && !seen[index] && (cells[index] == CELL_FENCE || index == head);
+        if (valid) seen[index] = 1;
+    }
+
+    // No body or fence tile left over
+    for (int i = 0; i < cellCount && valid; i++)
+        valid = seen[i] || i == head || (cells[i] != CELL_BODY && cells[i] != CELL_FENCE);
+    free(seen);
+    return valid;
+}
+
+// === CHECK A MAPPED SAVE ===
+// Everything a later step could index with is checked, so a damaged file is
+// refused instead of corrupting memory; the file is only read
+static bool ValidSave(const SaveMapping* save)
+{
+    if (save->size < sizeof(SaveHeader)) return false;
+    SaveHeader header;
+    memcpy(&header, save->base, sizeof(header));
+    if (header.magic != SAVE_MAGIC || header.version != SAVE_VERSION || header.headerSize != sizeof(SaveHeader))
+        return false;
+
+    // Counts, then the layout they give must be the one of the file
+    if (header.columns <= START_LENGTH + 1 || header.rows < 1 ||
+        (int64_t)header.columns * header.rows > INT32_MAX / (int64_t)sizeof(Cell))
+        return false;
+    int cellCount = header.columns * header.rows;
+    if (header.freeCount < 0 || header.freeCount > cellCount || header.length < 1 || header.length > cellCount ||
+        header.growth < 0 || header.fenceCount < 0 || header.fenceCount > MAX_FENCES ||
+        header.fruitCount < 0 || header.fruitCount > cellCount || header.fruitTarget < 1 || header.fruitTarget > cellCount)
+        return false;
+    SaveHeader layout = header;
+    SetSaveLayout(&layout);
+    if (layout.fileSize != save->size || layout.fileSize != header.fileSize ||
+        memcmp(&layout.cellsOffset, &header.cellsOffset, sizeof(uint64_t) * 7) != 0)
+        return false;
+
+    // Scalars
+    Board bounds = { .columns = header.columns, .rows = header.rows };
+    bool valid = header.landedOn >= CELL_EMPTY && header.landedOn <= CELL_FRUIT &&
+        header.direction >= DIRECTION_UP && header.direction <= DIRECTION_LEFT &&
+        header.nextDirection >= DIRECTION_UP && header.nextDirection <= DIRECTION_LEFT &&
+        header.lastEaten >= 0 && header.lastEaten < FRUIT_COUNT &&
+        isfinite(header.tickInterval) && header.tickInterval >= MIN_TICK_INTERVAL && // The tick loop relies on it
+        (header.random[1] & 1) && (header.cosmetic[1] & 1);
+    for (int i = 0; i < header.fenceCount && valid; i++)
+        valid = BoardContains(&bounds, (Cell){ header.fences[i][0], header.fences[i][1] });
+
+    // Segments: only the head of a finished game may be off the board
+    const Cell* segments = (const Cell*)(save->base + header.segmentsOffset);
+    for (int i = (header.over ? 1 : 0); i < header.length && valid; i++)
+        valid = BoardContains(&bounds, segments[i]);
+
+    // Board: the free list and its reverse index must describe the same empty
+    // cells, and the fruit pool and its slots the same fruit tiles
+    const unsigned char* cells = save->base + header.cellsOffset;
+    const int* freeCells = (const int*)(save->base + header.freeCellsOffset);
+    const int* freeSlot = (const int*)(save->base + header.freeSlotOffset);
+    const Fruit* fruits = (const Fruit*)(save->base + header.fruitsOffset);
+    const int* fruitSlot = (const int*)(save->base + header.fruitSlotOffset);
+    int empty = 0;
+    int fruitTiles = 0;
+    for (int i = 0; i < cellCount && valid; i++)
+    {
+        valid = cells[i] <= CELL_FRUIT;
+        if (cells[i] == CELL_EMPTY)
+        {
+            empty++;
+            valid = valid && freeSlot[i] >= 0 && freeSlot[i] < header.freeCount && freeCells[freeSlot[i]] == i;
+        }
+        else valid = valid && freeSlot[i] == -1;
+
+        if (cells[i] == CELL_FRUIT)
+        {
+            fruitTiles++;
+            int slot = fruitSlot[i];
+            valid = valid && slot >= 0 && slot < header.fruitCount &&
+                fruits[slot].position.x == i % header.columns && fruits[slot].position.y == i / header.columns &&
+                fruits[slot].type >= 0 && fruits[slot].type < FRUIT_COUNT;
+        }
+        else valid = valid && fruitSlot[i] == -1;
+    }
+    return valid && empty == header.freeCount && fruitTiles == header.fruitCount &&
+        MatchingBoard(&header, cells, segments);
+}
+
+// === LOAD A GAME ===
+bool LoadGameState(GameState* game, const char* path)
+{
+    SaveMapping save;
+    if (!MapSave(&save, path)) return false;
+    if (!ValidSave(&save))
+    {
+        UnmapSave(&save);
+        return false;
+    }
+    SaveHeader header;
+    memcpy(&header, save.base, sizeof(header));
+
+    // Another board size needs other buffers: allocated before the old ones go
+    if (header.columns != game->board.columns || header.rows != game->board.rows || !game->snake.cells)
+    {
+        GameState resized;
+        if (!InitGameState(&resized, header.columns, header.rows, 0))
+        {
+            UnmapSave(&save);
+            return false;
+        }
+        FreeGameState(game);
+        *game = resized;
+    }
+
+    // --- Arrays: one copy each ---
+    Board* board = &game->board;
+    Snake* snake = &game->snake;
+    size_t cellCount = (size_t)header.columns * (size_t)header.rows;
+    memcpy(board->cells, save.base + header.cellsOffset, cellCount);
+    memcpy(board->freeCells, save.base + header.freeCellsOffset, sizeof(int) * (size_t)header.freeCount);
+    memcpy(board->freeSlot, save.base + header.freeSlotOffset, sizeof(int) * cellCount);
+    memcpy(snake->cells, save.base + header.segmentsOffset, sizeof(Cell) * (size_t)header.length);
+    memcpy(game->fruits, save.base + header.fruitsOffset, sizeof(Fruit) * (size_t)header.fruitCount);
+    memcpy(game->fruitSlot, save.base + header.fruitSlotOffset, sizeof(int) * cellCount);
+    UnmapSave(&save);
+
+    // --- Scalars ---
+    board->freeCount = header.freeCount;
+    snake->headIndex = 0;
+    snake->length = header.length;
+    snake->growth = header.growth;
+    snake->landedOn = (CellType)header.landedOn;
+    game->direction = (Direction)header.direction;
+    game->nextDirection = (Direction)header.nextDirection;
+    game->fruitCount = header.fruitCount;
+    game->fruitTarget = header.fruitTarget;
+    game->lastEaten = (FruitType)header.lastEaten;
+    game->fenceCount = header.fenceCount;
+    for (int i = 0; i < header.fenceCount; i++)
+        game->fencePositions[i] = (Cell){ header.fences[i][0], header.fences[i][1] };
+    game->score = header.score;
+    game->tickCounter = header.tickCounter;
+    game->tickInterval = header.tickInterval;
+    game->over = header.over != 0;
+    game->won = header.won != 0;
+    game->random = (Rng){ header.random[0], header.random[1] };
+    game->cosmetic = (Rng){ header.cosmetic[0], header.cosmetic[1] };
+    RestoreSnakeExits(game);   // From the segments: the saved bytes are not trusted
+    return true;
+}
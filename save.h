@@ -0,0 +1,75 @@
+#ifndef SAVE_H
+#define SAVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sim.h"     // Game state being saved
+
+// === SAVE FILE FORMAT ===
+// The whole game in one flat file, written with a single fwrite and mapped
+// back into memory to be restored:
+//
+//   SaveHeader | board cells | free list | free slots | snake segments
+//             | fruits | fruit slots
+//
+// The header holds every scalar of the game; each array follows at the offset
+// the header gives (aligned to SAVE_ALIGNMENT) with the exact layout it has in
+// memory, so loading is one memcpy per array and never one allocation per
+// segment. Segments are stored head first, so the ring buffer starts at 0;
+// the direction each one leaves by is rebuilt from them on load.
+// Numbers are in the byte order of the machine that saved, like the asset pack:
+// a save with another magic, version or header size is refused.
+
+// === CONSTANTS ===
+#define SAVE_MAGIC 0x56534E53u      // "SNSV" read as a little-endian integer
+#define SAVE_VERSION 3              // Bump whenever the layout or GameState changes
+#define SAVE_FILE "quicksave.sns"   // Where the game quick-saves (F5) and quick-loads (F9)
+#define SAVE_ALIGNMENT 16           // Array alignment inside the file
+
+// === HEADER ===
+typedef struct SaveHeader
+{
+    uint32_t magic;              // SAVE_MAGIC
+    uint32_t version;            // SAVE_VERSION
+    uint32_t headerSize;         // sizeof(SaveHeader) of the build that saved
+    int32_t columns;             // Board width in tiles
+    int32_t rows;                // Board height in tiles
+    int32_t freeCount;           // Entries of the free list
+    int32_t length;              // Snake segments
+    int32_t growth;              // Segments still to add
+    int32_t landedOn;            // CellType the head found on the last move
+    int32_t direction;           // Direction
+    int32_t nextDirection;       // Direction
+    int32_t fruitCount;          // Fruits on the board
+    int32_t fruitTarget;         // Fruits kept on the board
+    int32_t lastEaten;           // FruitType
+    int32_t fenceCount;          // Fences used in fences[]
+    int32_t fences[MAX_FENCES][2]; // Fence positions (x, y)
+    int32_t score;
+    int32_t tickCounter;
+    float tickInterval;          // Milliseconds between two ticks
+    int32_t over;                // 0 or 1
+    int32_t won;                 // 0 or 1
+    uint32_t reserved[2];        // Zero: fills up to the 64-bit fields, so the header has no padding
+    uint64_t random[2];          // Gameplay stream: state, increment
+    uint64_t cosmetic[2];        // Cosmetic stream: state, increment
+    uint64_t cellsOffset;        // columns * rows CellType bytes
+    uint64_t freeCellsOffset;    // freeCount int32 cell indices
+    uint64_t freeSlotOffset;     // columns * rows int32 slots (-1 when occupied)
+    uint64_t segmentsOffset;     // length Cell, head first
+    uint64_t fruitsOffset;       // fruitCount Fruit
+    uint64_t fruitSlotOffset;    // columns * rows int32 slots (-1 when no fruit)
+    uint64_t fileSize;           // Total size, checked against the file
+} SaveHeader;
+
+// === FUNCTION PROTOTYPES ===
+
+// Write the whole game to a file in one write; returns false on failure
+bool SaveGameState(const GameState* game, const char* path);
+
+// Map a save and copy it into an initialized game, reallocated if the board
+// size differs; the game is left untouched if the file is refused
+bool LoadGameState(GameState* game, const char* path);
+
+#endif // SAVE_H
@@ -0,0 +1,401 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "board.h"
+
+// Movement of one tile for each direction
+static const Cell directionDelta[4] = {
+    { 0, -1 },  // DIRECTION_UP
+    { 1, 0 },   // DIRECTION_RIGHT
+    { 0, 1 },   // DIRECTION_DOWN
+    { -1, 0 }   // DIRECTION_LEFT
+};
+
+// === CREATE INITIAL SNAKE ===
+// Creates a snake with three segments: head -> body -> tail (legs), moving right
+static bool CreateSnake(GameState* game)
+{
+    Snake* snake = &game->snake;
+
+    // One cell per board tile: the snake can never be longer than the board
+    if (!snake->cells)
+    {
+        snake->capacity = game->board.columns * game->board.rows;
+        snake->cells = malloc(sizeof(Cell) * (size_t)snake->capacity);
+        snake->exits = malloc((size_t)snake->capacity);
+        if (!snake->cells || !snake->exits)
+        {
+            free(snake->cells);
+            free(snake->exits);
+            *snake = (Snake){ 0 };
+            return false;
+        }
+    }
+
+    // Head starts on the middle row, body and tail behind it
+    snake->headIndex = 0;
+    snake->length = START_LENGTH;
+    snake->growth = 0;
+    snake->landedOn = CELL_EMPTY;
+    for (int i = 0; i < START_LENGTH; i++)
+    {
+        snake->cells[i] = (Cell){ START_LENGTH + 1 - i, game->board.rows / 2 };
+        SetBoardCell(&game->board, snake->cells[i], CELL_BODY); // Occupy the tile
+        snake->exits[BoardIndex(&game->board, snake->cells[i])] = DIRECTION_RIGHT;
+    }
+
+    game->direction = DIRECTION_RIGHT;   // Initially move right
+    game->nextDirection = DIRECTION_RIGHT;
+    return true;
+}
+
+// === ACCESS A SEGMENT ===
+// Index 0 is the head, index length - 1 is the tail
+Cell SnakeSegment(const Snake* snake, int index)
+{
+    return snake->cells[(snake->headIndex + index) % snake->capacity];
+}
+
+// === RESTORE THE EXIT DIRECTIONS ===
+// Each segment left its tile towards the segment in front of it
+void RestoreSnakeExits(GameState* game)
+{
+    Snake* snake = &game->snake;
+    for (int i = 1; i < snake->length; i++)
+    {
+        Cell current = SnakeSegment(snake, i);
+        Cell front = SnakeSegment(snake, i - 1);
+        int index = BoardIndex(&game->board, current);
+        if (index < 0) continue;
+
+        Direction exit = DIRECTION_UP;
+        if (front.x > current.x) exit = DIRECTION_RIGHT;
+        else if (front.x < current.x) exit = DIRECTION_LEFT;
+        else if (front.y > current.y) exit = DIRECTION_DOWN;
+        snake->exits[index] = (unsigned char)exit;
+    }
+}
+
+// === SHRINK SNAKE ===
+// Pending growth is cancelled first, then the tail is cut off
+static void ShrinkSnake(GameState* game, int count)
+{
+    Snake* snake = &game->snake;
+    while (count > 0 && snake->growth > 0)
+    {
+        snake->growth--;
+        count--;
+    }
+
+    int removable = snake->length - 2; // Always keep head and tail
+    if (count > removable) count = removable;
+    for (int i = 0; i < count; i++)
+    {
+        SetBoardCell(&game->board, SnakeSegment(snake, snake->length - 1), CELL_EMPTY); // Free the tail tile
+        snake->length--;
+    }
+}
+
+// === APPLY PLAYER INPUT ===
+// Prevent 180-degree turns by checking the current direction
+void ApplyGameInput(GameState* game, GameInput input)
+{
+    if (input.turn == DIRECTION_NONE) return;
+
+    bool horizontal = (game->direction == DIRECTION_LEFT || game->direction == DIRECTION_RIGHT);
+    bool turnHorizontal = (input.turn == DIRECTION_LEFT || input.turn == DIRECTION_RIGHT);
+    if (horizontal != turnHorizontal)
+        game->nextDirection = input.turn; // Can only turn to a perpendicular direction
+}
+
+// === MOVE SNAKE ===
+// Moves the snake one tile in the current direction
+static void SnakeMovement(GameState* game)
+{
+    Snake* snake = &game->snake;
+    game->direction = game->nextDirection; // Apply the chosen next direction
+
+    Cell newPosition = SnakeSegment(snake, 0);             // Start from head's current position
+    snake->exits[BoardIndex(&game->board, newPosition)] = (unsigned char)game->direction; // The old head leaves its tile
+    newPosition.x += directionDelta[game->direction].x;   // Update head X position
+    newPosition.y += directionDelta[game->direction].y;   // Update head Y position
+
+    // Grow by keeping the tail, as long as the board has room for it
+    if (snake->growth > 0 && snake->length < snake->capacity)
+    {
+        snake->growth--;
+        snake->length++;
+    }
+    else
+    {
+        // The tail leaves its tile before the head arrives
+        SetBoardCell(&game->board, SnakeSegment(snake, snake->length - 1), CELL_EMPTY);
+    }
+
+    // Remember what the head runs into, then occupy its tile
+    snake->landedOn = GetBoardCell(&game->board, newPosition);
+    SetBoardCell(&game->board, newPosition, CELL_BODY);
+
+    // Push the new head in front of the old one; the old tail cell is
+    // reused when the snake did not grow
+    snake->headIndex = (snake->headIndex == 0) ? snake->capacity - 1 : snake->headIndex - 1;
+    snake->cells[snake->headIndex] = newPosition;
+}
+
+// === SPAWN FRUIT ===
+// Spawns one more fruit; returns false when the board is full
+static bool FruitSpawn(GameState* game)
+{
+    Cell newPos = { 0, 0 };         // Temporary position for new fruit
+
+    // Pick a random tile free of snake and fences
+    if (!RandomFreeCell(&game->board, NextRng(&game->random), &newPos)) return false; // No tile left
+
+    // Decide fruit type randomly (1 in 4 chance for special)
+    FruitType type = NORMAL_FRUIT;
+    int chance = RngRange(&game->random, 4); // 0..3
+    if (chance == 0)
+    {
+        // Random special fruit type (RED, BLUE, ORANGE, PURPLE)
+        type = (FruitType)(RED_FRUIT + RngRange(&game->random, PURPLE_FRUIT - RED_FRUIT + 1));
+    }
+
+    return PlaceFruit(game, newPos, type); // Add it to the pool and the board
+}
+
+// === CHECK COLLISION WITH FRUIT ===
+// Handles eating fruit, adding segments, applying effects
+static unsigned int FruitColision(GameState* game)
+{
+    if (game->snake.landedOn != CELL_FRUIT) return EVENT_NONE; // No fruit eaten
+
+    // The tile finds the fruit; the last one of the pool takes its slot
+    int index = BoardIndex(&game->board, SnakeSegment(&game->snake, 0));
+    int slot = game->fruitSlot[index];
+    unsigned int events = EVENT_ATE_FRUIT;
+    game->lastEaten = game->fruits[slot].type;
+    game->fruits[slot] = game->fruits[--game->fruitCount];
+    game->fruitSlot[BoardIndex(&game->board, game->fruits[slot].position)] = slot;
+    game->fruitSlot[index] = -1;        // The head is on the tile now
+
+    // --- ADD SEGMENT FOR EVERY FRUIT ---
+    game->snake.growth++;       // Tail is kept on the next move
+
+    // --- APPLY FRUIT TYPE EFFECTS ---
+    switch (game->lastEaten)
+    {
+    case NORMAL_FRUIT:
+        game->score++;          // Increase score
+        game->tickInterval -= 0.2f * SIM_FRAME_MS; // Slight speed up
+        break;
+    case RED_FRUIT: // Speed up
+        game->score++;
+        game->tickInterval -= 1.4f * SIM_FRAME_MS;
+        break;
+    case BLUE_FRUIT: // Slow down
+        game->score++;
+        game->tickInterval += 1.4f * SIM_FRAME_MS;
+        break;
+    case ORANGE_FRUIT: // Add 3 segments
+        game->score += 3;
+        game->snake.growth += 3;
+        break;
+    case PURPLE_FRUIT: // Remove 3 segments before tail if possible
+        ShrinkSnake(game, 3);   // Cut the tail, keeping head and legs
+        game->score -= 3;       // Decrease score
+        if (game->score < 0) game->score = 0;
+        break;
+    default:
+        break;
+    }
+    if (game->tickInterval < MIN_TICK_INTERVAL) game->tickInterval = MIN_TICK_INTERVAL; // Speed limit
+
+    // --- PLACE NEW FENCE AFTER EATING ---
+    Cell newFence = { 0, 0 };
+
+    // Pick a tile free of snake, fruit and existing fences (skipped if the board is full)
+    if (game->fenceCount < MAX_FENCES && RandomFreeCell(&game->board, NextRng(&game->random), &newFence))
+    {
+        game->fencePositions[game->fenceCount] = newFence; // Save new fence position
+        game->fenceCount++;                                // Increment fence count
+        SetBoardCell(&game->board, newFence, CELL_FENCE);  // Occupy the tile
+        events |= EVENT_FENCE_PLACED;
+    }
+    return events;
+}
+
+// === INITIALIZE A GAME ===
+bool InitGameState(GameState* game, int columns, int rows, unsigned int seed)
+{
+    *game = (GameState){ 0 };
+    if (columns <= START_LENGTH + 1 || rows < 1) return false; // Snake must fit on its row
+    if (!InitBoard(&game->board, columns, rows)) return false;
+
+    // Fruit pool: room for one per tile, no tile holds one yet
+    size_t cellCount = (size_t)columns * (size_t)rows;
+    game->fruits = malloc(sizeof(Fruit) * cellCount);
+    game->fruitSlot = malloc(sizeof(int) * cellCount);
+    game->fruitTarget = 1;      // Classic game: one fruit at a time
+    if (!game->fruits || !game->fruitSlot)
+    {
+        FreeGameState(game);
+        return false;
+    }
+    for (size_t i = 0; i < cellCount; i++)
+        game->fruitSlot[i] = -1;
+
+    SeedGameState(game, seed);  // Fruit and fence placement
+    ResetGameState(game);
+    if (!game->snake.cells)
+    {
+        FreeGameState(game);
+        return false;
+    }
+    return true;
+}
+
+// === RESET GAME ===
+// Reset snake, score, fruit and fences for a new round
+void ResetGameState(GameState* game)
+{
+    ClearBoard(&game->board);   // Empty every tile
+    ClearFruits(game);          // Empty the fruit pool
+    CreateSnake(game);          // Create a new snake (reuses its buffer)
+
+    game->lastEaten = NORMAL_FRUIT;
+    game->fenceCount = 0;       // Reset fence count
+    game->score = 0;            // Reset score
+    game->tickCounter = 0;
+    game->tickInterval = START_TICK_INTERVAL;
+    game->over = false;
+    game->won = false;
+
+    // First fruits are visible before the first move
+    while (game->fruitCount < game->fruitTarget && FruitSpawn(game)) {}
+}
+
+// === SEED THE RANDOM STREAMS ===
+// Same seed, same game: the cosmetic stream is separate so audio never shifts the rules
+void SeedGameState(GameState* game, unsigned int seed)
+{
+    SeedRng(&game->random, seed, RNG_STREAM_GAMEPLAY);
+    SeedRng(&game->cosmetic, seed, RNG_STREAM_COSMETIC);
+}
+
+// === ADVANCE THE GAME BY ONE TICK ===
+unsigned int GameStep(GameState* game, GameInput input)
+{
+    if (game->over) return EVENT_NONE; // Nothing happens after the end
+
+    unsigned int events = EVENT_MOVED;
+    game->tickCounter++;
+
+    ApplyGameInput(game, input);        // Handle player input
+    SnakeMovement(game);                // Move snake
+    events |= FruitColision(game);      // Check for collisions with fruit
+
+    // Check for collisions with the snake itself, the borders and the fences
+    Cell head = SnakeSegment(&game->snake, 0);
+    if (game->snake.landedOn == CELL_BODY || game->snake.landedOn == CELL_FENCE ||
+        !BoardContains(&game->board, head))
+    {
+        game->over = true;
+        return events | EVENT_DIED;
+    }
+
+    // Replace the eaten fruit (or every missing one after the fruit target grew)
+    while (game->fruitCount < game->fruitTarget && FruitSpawn(game))
+        events |= EVENT_FRUIT_SPAWN;
+    if (game->fruitCount == 0)
+    {
+        game->won = true;               // No fruit and no tile left: the board is full
+        game->over = true;
+        events |= EVENT_WON;
+    }
+    return events;
+}
+
+// === COPY A GAME ===
+// The buffers of the destination are kept: only their contents are copied
+bool CopyGameState(GameState* destination, const GameState* source)
+{
+    if (destination->board.columns != source->board.columns || destination->board.rows != source->board.rows ||
+        !destination->snake.cells || !source->snake.cells)
+        return false;
+
+    size_t cellCount = (size_t)source->board.columns * (size_t)source->board.rows;
+    Board board = destination->board;
+    Snake snake = destination->snake;
+    memcpy(board.cells, source->board.cells, cellCount);
+    memcpy(board.freeCells, source->board.freeCells, sizeof(int) * cellCount);
+    memcpy(board.freeSlot, source->board.freeSlot, sizeof(int) * cellCount);
+    memcpy(snake.cells, source->snake.cells, sizeof(Cell) * (size_t)source->snake.capacity);
+    memcpy(snake.exits, source->snake.exits, (size_t)source->snake.capacity);
+    Fruit* fruits = destination->fruits;
+    int* fruitSlot = destination->fruitSlot;
+    memcpy(fruits, source->fruits, sizeof(Fruit) * (size_t)source->fruitCount);
+    memcpy(fruitSlot, source->fruitSlot, sizeof(int) * cellCount);
+
+    *destination = *source;
+    destination->board.cells = board.cells;
+    destination->board.freeCells = board.freeCells;
+    destination->board.freeSlot = board.freeSlot;
+    destination->snake.cells = snake.cells;
+    destination->snake.exits = snake.exits;
+    destination->fruits = fruits;
+    destination->fruitSlot = fruitSlot;
+    return true;
+}
+
+// === NUMBER OF FRUITS ===
+void SetFruitTarget(GameState* game, int count)
+{
+    int cellCount = game->board.columns * game->board.rows;
+    game->fruitTarget = (count < 1) ? 1 : (count > cellCount) ? cellCount : count;
+}
+
+// === ADD A FRUIT TO THE POOL ===
+bool PlaceFruit(GameState* game, Cell cell, FruitType type)
+{
+    int index = BoardIndex(&game->board, cell);
+    if (index < 0 || game->board.cells[index] != CELL_EMPTY) return false;
+
+    game->fruitSlot[index] = game->fruitCount;
+    game->fruits[game->fruitCount++] = (Fruit){ cell, type };
+    SetBoardCell(&game->board, cell, CELL_FRUIT);
+    return true;
+}
+
+// === EMPTY THE POOL ===
+// Tiles the snake took over are left as they are
+void ClearFruits(GameState* game)
+{
+    for (int i = 0; i < game->fruitCount; i++)
+    {
+        Cell cell = game->fruits[i].position;
+        if (GetBoardCell(&game->board, cell) == CELL_FRUIT)
+            SetBoardCell(&game->board, cell, CELL_EMPTY);
+        game->fruitSlot[BoardIndex(&game->board, cell)] = -1;
+    }
+    game->fruitCount = 0;
+}
+
+// === FIND THE FRUIT ON A TILE ===
+const Fruit* FruitAt(const GameState* game, Cell cell)
+{
+    int index = BoardIndex(&game->board, cell);
+    if (index < 0 || game->fruitSlot[index] < 0) return NULL;
+    return &game->fruits[game->fruitSlot[index]];
+}
+
+// === FREE GAME MEMORY ===
+void FreeGameState(GameState* game)
+{
+    free(game->snake.cells);    // Free the snake buffer
+    free(game->snake.exits);    // Free the exit directions
+    free(game->fruits);         // Free the fruit pool
+    free(game->fruitSlot);
+    FreeBoard(&game->board);    // Free the occupancy grid
+    *game = (GameState){ 0 };
+}
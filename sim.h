@@ -0,0 +1,159 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "board.h"  // Occupancy grid and cell coordinates
+#include "rng.h"    // Seeded random streams
+
+// === HEADLESS SIMULATION CORE ===
+// Game rules only: no window, no input device, no audio. Each GameStep() is
+// one logic tick: the snake moves one tile and collisions are checked. The
+// raylib screens run ticks every tickInterval milliseconds of real time and
+// react to the events returned; bots, tests and benchmarks call it directly.
+
+// === CONSTANTS ===
+#define MAX_FENCES 100       // Maximum number of fences on the field
+#define START_LENGTH 3       // Number of segments of a new snake
+#define SIM_FRAME_MS (1000.0f / 60.0f)             // One frame of the original 60 FPS timing
+#define START_TICK_INTERVAL (10.0f * SIM_FRAME_MS)  // Milliseconds between two moves at the start
+#define MIN_TICK_INTERVAL SIM_FRAME_MS              // Fastest speed the fruits can reach
+#define FEAST_FRUITS 5       // Fruits kept on the board in feast mode unless told otherwise
+
+// === FRUIT TYPES ENUM ===
+typedef enum FruitType
+{
+    NORMAL_FRUIT,  // Normal fruit
+    RED_FRUIT,     // Red fruit
+    BLUE_FRUIT,    // Blue fruit
+    ORANGE_FRUIT,  // Orange fruit
+    PURPLE_FRUIT,  // Purple fruit
+    FRUIT_COUNT    // Total number of fruit types
+} FruitType;
+
+// === DIRECTIONS ===
+// Ordered clockwise so that direction * 90 is the sprite rotation
+typedef enum Direction
+{
+    DIRECTION_NONE = -1, // No turn requested
+    DIRECTION_UP,
+    DIRECTION_RIGHT,
+    DIRECTION_DOWN,
+    DIRECTION_LEFT
+} Direction;
+
+// === SNAKE BODY STRUCTURE ===
+// The body is a preallocated circular buffer: segment 0 is the head at
+// cells[headIndex], segment i is at cells[(headIndex + i) % capacity].
+// Moving pushes a new head in front and drops the tail, both in O(1).
+// exits[] remembers, for each board tile, the direction the snake took when
+// leaving it: the way a segment faces can be read from its tile alone.
+typedef struct Snake
+{
+    Cell* cells;             // Circular buffer holding every segment
+    unsigned char* exits;    // Direction taken out of each board tile (indexed like the board)
+    int capacity;            // Number of cells in the buffer (one per board tile)
+    int headIndex;           // Index of the head segment in the buffer
+    int length;              // Number of segments currently in the snake
+    int growth;              // Segments still to add (tail is kept on the next moves)
+    CellType landedOn;       // What the head found on its tile during the last move
+} Snake;
+
+// === FRUIT ON THE BOARD ===
+typedef struct Fruit
+{
+    Cell position;           // Tile of the fruit
+    FruitType type;          // Effect when eaten
+} Fruit;
+
+// === GAME EVENTS ===
+// Bit flags returned by GameStep()
+typedef enum GameEvent
+{
+    EVENT_NONE         = 0,
+    EVENT_MOVED        = 1 << 0, // The snake moved one tile (every tick)
+    EVENT_FRUIT_SPAWN  = 1 << 1, // New fruits appeared
+    EVENT_ATE_FRUIT    = 1 << 2, // The snake ate a fruit (type in lastEaten)
+    EVENT_FENCE_PLACED = 1 << 3, // A fence was added after eating
+    EVENT_DIED         = 1 << 4, // The snake hit itself, a border or a fence
+    EVENT_WON          = 1 << 5  // No tile left for a new fruit
+} GameEvent;
+
+// === PLAYER INPUT FOR ONE STEP ===
+typedef struct GameInput
+{
+    Direction turn;          // Requested direction, or DIRECTION_NONE
+} GameInput;
+
+// === FULL STATE OF ONE GAME ===
+// The fruits are a compact pool: fruits[0..fruitCount) are on the board in no
+// particular order, and fruitSlot[tile] finds the one on a tile in O(1), so
+// eating costs the same with one fruit (classic) or thousands (feast mode).
+typedef struct GameState
+{
+    Board board;             // Occupancy grid
+    Snake snake;             // Snake body
+    Direction direction;     // Current movement direction
+    Direction nextDirection; // Direction applied on the next move
+
+    Fruit* fruits;           // Fruits on the board (one entry allocated per tile)
+    int* fruitSlot;          // Index in fruits of the fruit on each tile, -1 if none
+    int fruitCount;          // Fruits on the board
+    int fruitTarget;         // Fruits kept on the board: 1, or more in feast mode
+    FruitType lastEaten;     // Type of the last fruit eaten
+
+    Cell fencePositions[MAX_FENCES]; // Positions of all fences
+    int fenceCount;          // Current number of fences on the field
+
+    int score;               // Current score
+    int tickCounter;         // Ticks since the start of the game
+    float tickInterval;      // Milliseconds between two ticks (controls speed)
+    bool over;               // The game has ended (died or won)
+    bool won;                // The game ended with a full board
+    Rng random;              // Gameplay stream: fruit and fence placement
+    Rng cosmetic;            // Cosmetic stream: music picks, never read by the rules
+} GameState;
+
+// === FUNCTION PROTOTYPES ===
+
+// Allocate a game on a board of the given size, seed it and reset it; returns false on failure
+bool InitGameState(GameState* game, int columns, int rows, unsigned int seed);
+
+// Start a new round on the same board (snake, fruit, fences, score)
+void ResetGameState(GameState* game);
+
+// Seed the gameplay and cosmetic random streams
+void SeedGameState(GameState* game, unsigned int seed);
+
+// Apply a turn request to the next move without advancing the game
+void ApplyGameInput(GameState* game, GameInput input);
+
+// Advance the game by one tick and return the GameEvent flags that happened
+unsigned int GameStep(GameState* game, GameInput input);
+
+// Keep this many fruits on the board (feast mode above 1); the missing ones spawn on the next step
+void SetFruitTarget(GameState* game, int count);
+
+// Put a fruit on an empty tile; returns false if the tile is taken or off the board
+bool PlaceFruit(GameState* game, Cell cell, FruitType type);
+
+// Take every fruit off the board
+void ClearFruits(GameState* game);
+
+// Returns the fruit on a tile, or NULL
+const Fruit* FruitAt(const GameState* game, Cell cell);
+
+// Returns the segment at the given index (0 = head, length - 1 = tail)
+Cell SnakeSegment(const Snake* snake, int index);
+
+// Recompute the exit direction of every segment after the body was written directly
+void RestoreSnakeExits(GameState* game);
+
+// Copy a game into another one initialized with the same board size; returns false if the sizes differ
+bool CopyGameState(GameState* destination, const GameState* source);
+
+// Free the memory owned by a game
+void FreeGameState(GameState* game);
+
+#endif // SIM_H
@@ -3,42 +3,15 @@
 
 #include <raylib.h>
 
-// === SNAKE SEGMENT STRUCTURE ===
-typedef struct Segment
-{
-    Vector2 position;        // Position of this segment on the grid
-    struct Segment* next;    // Pointer to the next segment in the snake
-} Segment;
-
-// === GLOBAL VARIABLES FOR THE SNAKE ===
-extern Segment* head;        // Pointer to the head segment of the snake
-extern Vector2 direction;    // Current movement direction of the snake
-extern Vector2 nextDirection; // Next direction the snake will move (based on input)
+#include "sim.h"     // Snake body and directions
+#include "input.h"   // Queue of player turns
 
 // === FUNCTION PROTOTYPES ===
 
-// Creates a new snake with head, body, and tail segments
-Segment* CreateSnake(void);
-
-// Initializes the snake at the start of the game
-void InitializeSnake(void);
-
-// Handles player input to change the snake's direction
-void SnakeDirectionInput(void);
-
-// Moves the snake based on the current direction
-void SnakeMovement(void);
-
-// Checks for collision with itself (snake biting its own body)
-void SelfColision(void);
-
-// Checks for collision with screen borders
-void BorderColision(void);
-
-// Draws the snake on the screen using textures
-void DrawSnake(void);
+// Queues every arrow key pressed since the last frame, in order, with the time it was read
+void SnakeDirectionInput(TurnQueue* queue);
 
-// Frees memory used by the snake's linked list
-void FreeSnake(void);
+// Converts a board cell to the world position of its top-left corner (see boardCamera)
+Vector2 CellToWorld(Cell cell);
 
 #endif // SNAKE_H
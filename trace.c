@@ -0,0 +1,199 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L    // clock_gettime
+#endif
+
+#include "trace.h"
+
+#ifdef SNAKE_TRACE
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// === ONE FINISHED ZONE ===
+typedef struct TraceZone
+{
+    const char* name;        // Zone name (string literal)
+    uint64_t start;          // Start time (ns)
+    uint64_t duration;       // Duration (ns)
+} TraceZone;
+
+// === RING BUFFER OF ONE THREAD ===
+// Only its thread writes; the exporter reads up to the published count
+typedef struct TraceBuffer
+{
+    TraceZone zones[TRACE_RING_SIZE];          // Finished zones
+    atomic_uint_fast64_t written;              // Zones ever written (index = written % size)
+    int threadId;                              // Thread number in the trace
+    const char* openNames[TRACE_MAX_DEPTH];    // Zones begun and not yet ended
+    uint64_t openStarts[TRACE_MAX_DEPTH];      // Their start times
+    int depth;                                 // Number of open zones
+} TraceBuffer;
+
+// === TRACE STATE ===
+static _Atomic(TraceBuffer*) buffers[TRACE_MAX_THREADS]; // Buffer of every thread that traced (NULL until published)
+static atomic_int bufferCount;                    // Buffers handed out
+static _Thread_local TraceBuffer* threadBuffer;   // Buffer of the calling thread
+static _Thread_local bool threadRefused;          // No buffer left for this thread
+
+static float frameTimes[TRACE_FRAME_HISTORY];     // Last frame durations (ms)
+static int frameCount = 0;                        // Frames measured (capped at the history size)
+static int frameNext = 0;                         // Next slot of frameTimes
+static uint64_t lastFrame = 0;                    // Time of the previous TraceFrame()
+
+// === CLOCK ===
+// Monotonic nanoseconds
+static uint64_t TraceNow(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000u +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000u / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+// === BUFFER OF THE CALLING THREAD ===
+// Allocated on the first zone of each thread
+static TraceBuffer* GetThreadBuffer(void)
+{
+    if (threadBuffer || threadRefused) return threadBuffer;
+
+    int slot = atomic_fetch_add(&bufferCount, 1);
+    TraceBuffer* buffer = (slot < TRACE_MAX_THREADS) ? calloc(1, sizeof(TraceBuffer)) : NULL;
+    if (!buffer)
+    {
+        threadRefused = true;   // Too many threads: this one is not traced
+        return NULL;
+    }
+    buffer->threadId = slot + 1;
+    atomic_init(&buffer->written, 0);
+    atomic_store_explicit(&buffers[slot], buffer, memory_order_release); // The exporter may read it at once
+    threadBuffer = buffer;
+    return buffer;
+}
+
+// === OPEN A ZONE ===
+void TraceBegin(const char* name)
+{
+    TraceBuffer* buffer = GetThreadBuffer();
+    if (!buffer) return;
+    if (buffer->depth < TRACE_MAX_DEPTH)
+    {
+        buffer->openNames[buffer->depth] = name;
+        buffer->openStarts[buffer->depth] = TraceNow();
+    }
+    buffer->depth++;    // Counted even when too deep, to keep BEGIN/END paired
+}
+
+// === CLOSE A ZONE ===
+void TraceEnd(void)
+{
+    TraceBuffer* buffer = threadBuffer;
+    if (!buffer || buffer->depth == 0) return;
+    buffer->depth--;
+    if (buffer->depth >= TRACE_MAX_DEPTH) return;
+
+    uint64_t written = atomic_load_explicit(&buffer->written, memory_order_relaxed);
+    TraceZone* zone = &buffer->zones[written % TRACE_RING_SIZE];
+    zone->name = buffer->openNames[buffer->depth];
+    zone->start = buffer->openStarts[buffer->depth];
+    zone->duration = TraceNow() - zone->start;
+    atomic_store_explicit(&buffer->written, written + 1, memory_order_release); // Publish to the exporter
+}
+
+// === END OF A FRAME ===
+void TraceFrame(void)
+{
+    uint64_t now = TraceNow();
+    if (lastFrame != 0)
+    {
+        frameTimes[frameNext] = (float)(now - lastFrame) * 1e-6f;
+        frameNext = (frameNext + 1) % TRACE_FRAME_HISTORY;
+        if (frameCount < TRACE_FRAME_HISTORY) frameCount++;
+    }
+    lastFrame = now;
+}
+
+static int CompareFloats(const void* a, const void* b)
+{
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+// === FRAME TIME PERCENTILES ===
+bool GetFrameStats(FrameStats* stats)
+{
+    if (frameCount < 2) return false;
+
+    float sorted[TRACE_FRAME_HISTORY];
+    memcpy(sorted, frameTimes, sizeof(float) * (size_t)frameCount);
+    qsort(sorted, (size_t)frameCount, sizeof(float), CompareFloats);
+    stats->p50 = sorted[frameCount / 2];
+    stats->p99 = sorted[(frameCount * 99) / 100];
+    stats->max = sorted[frameCount - 1];
+    stats->frames = frameCount;
+    return true;
+}
+
+// === CHROME TRACE EXPORT ===
+// Complete events ("ph": "X") with microsecond times. A thread may keep
+// writing during the export: zones it overwrites meanwhile can come out mixed.
+bool ExportTrace(const char* path)
+{
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+    int count = atomic_load(&bufferCount);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+    for (int b = 0; b < count; b++)
+    {
+        TraceBuffer* buffer = atomic_load_explicit(&buffers[b], memory_order_acquire);
+        if (!buffer) continue;   // Slot claimed, buffer not published yet
+
+        uint64_t written = atomic_load_explicit(&buffer->written, memory_order_acquire);
+        uint64_t oldest = (written > TRACE_RING_SIZE) ? written - TRACE_RING_SIZE : 0;
+        for (uint64_t i = oldest; i < written; i++)
+        {
+            const TraceZone* zone = &buffer->zones[i % TRACE_RING_SIZE];
+            fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                first ? "" : ",\n", zone->name, buffer->threadId,
+                (double)zone->start * 1e-3, (double)zone->duration * 1e-3);
+            first = false;
+        }
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+// === FREE THE BUFFERS ===
+// Other threads must have stopped tracing
+void ShutdownTrace(void)
+{
+    int count = atomic_load(&bufferCount);
+    if (count > TRACE_MAX_THREADS) count = TRACE_MAX_THREADS;
+    for (int b = 0; b < count; b++)
+    {
+        free(atomic_load_explicit(&buffers[b], memory_order_relaxed));
+        atomic_store_explicit(&buffers[b], NULL, memory_order_relaxed);
+    }
+    atomic_store(&bufferCount, 0);
+    threadBuffer = NULL;
+}
+
+#endif // SNAKE_TRACE
@@ -0,0 +1,69 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// === HOT-PATH TRACING ===
+// Timing zones recorded into a ring buffer per thread, exported on demand as
+// Chrome trace JSON (chrome://tracing or ui.perfetto.dev). Without
+// SNAKE_TRACE the zone macros expand to nothing and this module is empty.
+//
+//   TRACE_BEGIN("simulation");
+//   ... work ...
+//   TRACE_END();
+//
+// Zone names must be string literals (only the pointer is stored) and every
+// TRACE_BEGIN needs its TRACE_END on the same thread.
+
+// === CONSTANTS ===
+#define TRACE_RING_SIZE 16384      // Zones kept per thread (oldest are overwritten)
+#define TRACE_MAX_THREADS 16       // Threads that can record zones
+#define TRACE_MAX_DEPTH 16         // Nested zones per thread
+#define TRACE_FRAME_HISTORY 600    // Frames used for the frame time statistics (10 s at 60 FPS)
+#define TRACE_FILE "trace.json"    // Where the game exports the trace
+
+#ifdef SNAKE_TRACE
+#define TRACE_BEGIN(name) TraceBegin(name)
+#define TRACE_END() TraceEnd()
+#define TRACE_FRAME() TraceFrame()
+#else
+#define TRACE_BEGIN(name) ((void)(name))
+#define TRACE_END() ((void)0)
+#define TRACE_FRAME() ((void)0)
+#endif
+
+// === FRAME TIME STATISTICS ===
+typedef struct FrameStats
+{
+    float p50;           // Median frame time (ms)
+    float p99;           // 99th percentile frame time (ms)
+    float max;           // Longest frame time (ms)
+    int frames;          // Frames the statistics cover
+} FrameStats;
+
+#ifdef SNAKE_TRACE
+
+// === FUNCTION PROTOTYPES ===
+
+// Open a zone on the calling thread
+void TraceBegin(const char* name);
+
+// Close the last zone opened on the calling thread
+void TraceEnd(void);
+
+// Mark the end of a frame (main thread): feeds the frame time statistics
+void TraceFrame(void);
+
+// Frame time percentiles over the last TRACE_FRAME_HISTORY frames; false before two frames
+bool GetFrameStats(FrameStats* stats);
+
+// Write every zone still in the ring buffers as Chrome trace JSON
+bool ExportTrace(const char* path);
+
+// Free the ring buffers
+void ShutdownTrace(void);
+
+#endif // SNAKE_TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,314 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+#include "vecenv.h"
+#include "sim.h"
+#include "board.h"
+
+// One worker thread and the games it steps
+typedef struct VecEnvWorker
+{
+    thrd_t thread;
+    struct VecEnv* env;
+    int first;               // First game of its share
+    int end;                 // One past its last game
+} VecEnvWorker;
+
+// === ENVIRONMENT STRUCT ===
+struct VecEnv
+{
+    GameState* games;        // The games, one board each
+    unsigned int* seeds;     // Seed of the next game of each slot
+    int count;               // Number of games
+    int planeWords;          // 64-bit words per board plane
+    int maxTicks;            // Truncation limit (0 = never)
+
+    // Buffers handed to the caller, and the actions of the step being run
+    const Direction* actions;
+    uint64_t* observations;
+    float* rewards;
+    unsigned char* dones;
+
+    // Worker threads: they sleep until generation changes
+    VecEnvWorker* workers;   // threadCount - 1 workers; the caller steps the first share
+    int threadCount;         // Threads stepping the games, the caller's included
+    mtx_t lock;              // Protects generation, pending and quit
+    cnd_t start;             // Signalled when a new step begins
+    cnd_t finished;          // Signalled when the last worker is done
+    unsigned int generation; // Number of steps started
+    int pending;             // Workers still stepping the current step
+    bool quit;               // Workers must exit
+};
+
+// === START THE NEXT GAME OF A SLOT ===
+static void StartGame(VecEnv* env, int index)
+{
+    GameState* game = &env->games[index];
+    SeedGameState(game, env->seeds[index]);
+    ResetGameState(game);
+    env->seeds[index] += (unsigned int)env->count;   // Slots never share a seed
+}
+
+// === WRITE THE OBSERVATION OF ONE GAME ===
+// Only the occupied cells are visited: the planes are cleared, then the
+// snake, the fences and the fruits set their bits
+static void WriteObservation(VecEnv* env, int index)
+{
+    const GameState* game = &env->games[index];
+    size_t planeStride = (size_t)env->count * (size_t)env->planeWords;
+    uint64_t* planes = env->observations + (size_t)index * (size_t)env->planeWords;
+    for (int p = 0; p < ENV_PLANE_COUNT; p++)
+        memset(planes + p * planeStride, 0, sizeof(uint64_t) * (size_t)env->planeWords);
+
+    uint64_t* body = planes + ENV_PLANE_BODY * planeStride;
+    for (int i = 0; i < game->snake.length; i++)
+    {
+        int cell = BoardIndex(&game->board, SnakeSegment(&game->snake, i));
+        if (cell >= 0) body[cell / 64] |= 1ull << (cell % 64);   // The head may be off the board after a crash
+    }
+
+    int head = BoardIndex(&game->board, SnakeSegment(&game->snake, 0));
+    if (head >= 0) planes[ENV_PLANE_HEAD * planeStride + (size_t)(head / 64)] |= 1ull << (head % 64);
+
+    uint64_t* fences = planes + ENV_PLANE_FENCE * planeStride;
+    for (int i = 0; i < game->fenceCount; i++)
+    {
+        int cell = BoardIndex(&game->board, game->fencePositions[i]);
+        fences[cell / 64] |= 1ull << (cell % 64);
+    }
+
+    for (int i = 0; i < game->fruitCount; i++)
+    {
+        const Fruit* fruit = &game->fruits[i];
+        int cell = BoardIndex(&game->board, fruit->position);
+        planes[(ENV_PLANE_FRUIT + fruit->type) * planeStride + (size_t)(cell / 64)] |= 1ull << (cell % 64);
+    }
+}
+
+// === STEP A SHARE OF THE GAMES ===
+// The reward is the score change of the tick, so the fruit rules of
+// FruitColision() are rewarded as the player sees them (purple fruits cost 3)
+static void StepGames(VecEnv* env, int first, int end)
+{
+    for (int i = first; i < end; i++)
+    {
+        GameState* game = &env->games[i];
+        Direction action = env->actions[i];
+        if (action < DIRECTION_NONE || action > DIRECTION_LEFT) action = DIRECTION_NONE; // Unknown action: keep going
+
+        int score = game->score;
+        GameStep(game, (GameInput){ action });
+
+        float reward = (float)(game->score - score);
+        unsigned char done = ENV_RUNNING;
+        if (game->over)
+        {
+            done = ENV_TERMINATED;
+            if (!game->won) reward += VECENV_DEATH_REWARD;
+        }
+        else if (env->maxTicks > 0 && game->tickCounter >= env->maxTicks)
+            done = ENV_TRUNCATED;
+
+        if (done != ENV_RUNNING) StartGame(env, i);  // The caller gets the first observation of the next game
+        env->rewards[i] = reward;
+        env->dones[i] = done;
+        WriteObservation(env, i);
+    }
+}
+
+// === WORKER THREAD ===
+// Sleeps until a step starts, steps its share, reports, and sleeps again
+static int VecEnvWorkerMain(void* argument)
+{
+    VecEnvWorker* worker = argument;
+    VecEnv* env = worker->env;
+    unsigned int seen = 0;
+
+    for (;;)
+    {
+        mtx_lock(&env->lock);
+        while (env->generation == seen && !env->quit)
+            cnd_wait(&env->start, &env->lock);
+        bool quit = env->quit;
+        seen = env->generation;
+        mtx_unlock(&env->lock);
+        if (quit) return 0;
+
+        StepGames(env, worker->first, worker->end);
+
+        mtx_lock(&env->lock);
+        if (--env->pending == 0) cnd_signal(&env->finished);
+        mtx_unlock(&env->lock);
+    }
+}
+
+// === CREATE THE ENVIRONMENT ===
+VecEnv* CreateVecEnv(const VecEnvConfig* config)
+{
+    if (config->count < 1) return NULL;
+    VecEnv* env = calloc(1, sizeof(VecEnv));
+    if (!env) return NULL;
+    if (mtx_init(&env->lock, mtx_plain) != thrd_success)
+    {
+        free(env);
+        return NULL;
+    }
+    if (cnd_init(&env->start) != thrd_success)
+    {
+        mtx_destroy(&env->lock);
+        free(env);
+        return NULL;
+    }
+    if (cnd_init(&env->finished) != thrd_success)
+    {
+        cnd_destroy(&env->start);
+        mtx_destroy(&env->lock);
+        free(env);
+        return NULL;
+    }
+
+    env->maxTicks = config->maxTicks;
+    env->planeWords = (config->columns * config->rows + 63) / 64;
+    env->games = calloc((size_t)config->count, sizeof(GameState));
+    env->seeds = malloc(sizeof(unsigned int) * (size_t)config->count);
+    env->observations = calloc((size_t)ENV_PLANE_COUNT * (size_t)config->count * (size_t)env->planeWords, sizeof(uint64_t));
+    env->rewards = calloc((size_t)config->count, sizeof(float));
+    env->dones = calloc((size_t)config->count, 1);
+    if (!env->games || !env->seeds || !env->observations || !env->rewards || !env->dones)
+    {
+        DestroyVecEnv(env);
+        return NULL;
+    }
+
+    // count only covers the games created, so a failure frees exactly those
+    for (int i = 0; i < config->count; i++)
+    {
+        env->seeds[i] = config->seed + (unsigned int)i;
+        if (!InitGameState(&env->games[i], config->columns, config->rows, env->seeds[i]))
+        {
+            DestroyVecEnv(env);
+            return NULL;
+        }
+        env->count++;
+    }
+
+    // Contiguous shares: the caller takes the first one, each worker the next
+    int threads = config->threads;
+    if (threads > env->count) threads = env->count;
+    if (threads < 1) threads = 1;
+    env->threadCount = 1;
+    if (threads > 1)
+    {
+        env->workers = calloc((size_t)(threads - 1), sizeof(VecEnvWorker));
+        if (!env->workers)
+        {
+            DestroyVecEnv(env);
+            return NULL;
+        }
+    }
+    for (int i = 1; i < threads; i++)
+    {
+        VecEnvWorker* worker = &env->workers[i - 1];
+        worker->env = env;
+        worker->first = (int)((long long)env->count * i / threads);
+        worker->end = (int)((long long)env->count * (i + 1) / threads);
+        if (thrd_create(&worker->thread, VecEnvWorkerMain, worker) != thrd_success)
+        {
+            DestroyVecEnv(env);
+            return NULL;
+        }
+        env->threadCount++;
+    }
+    return env;
+}
+
+// === NUMBER OF GAMES ===
+int VecEnvCount(const VecEnv* env)
+{
+    return env->count;
+}
+
+// === SIZE OF THE OBSERVATION BUFFER ===
+size_t VecEnvObservationWords(const VecEnv* env)
+{
+    return (size_t)ENV_PLANE_COUNT * (size_t)env->count * (size_t)env->planeWords;
+}
+
+// === BUFFERS OF THE RESULTS ===
+uint64_t* VecEnvObservations(VecEnv* env)
+{
+    return env->observations;
+}
+
+float* VecEnvRewards(VecEnv* env)
+{
+    return env->rewards;
+}
+
+unsigned char* VecEnvDones(VecEnv* env)
+{
+    return env->dones;
+}
+
+// === RESET EVERY GAME ===
+void ResetVecEnv(VecEnv* env)
+{
+    for (int i = 0; i < env->count; i++)
+    {
+        StartGame(env, i);
+        WriteObservation(env, i);
+    }
+}
+
+// === STEP EVERY GAME ===
+void StepVecEnv(VecEnv* env, const Direction* actions)
+{
+    env->actions = actions;
+
+    if (env->threadCount == 1)
+    {
+        StepGames(env, 0, env->count);
+        return;
+    }
+
+    // Wake the workers, step the first share meanwhile, then wait for them
+    mtx_lock(&env->lock);
+    env->generation++;
+    env->pending = env->threadCount - 1;
+    cnd_broadcast(&env->start);
+    mtx_unlock(&env->lock);
+
+    StepGames(env, 0, env->workers[0].first);
+
+    mtx_lock(&env->lock);
+    while (env->pending > 0)
+        cnd_wait(&env->finished, &env->lock);
+    mtx_unlock(&env->lock);
+}
+
+// === FREE THE ENVIRONMENT ===
+void DestroyVecEnv(VecEnv* env)
+{
+    if (!env) return;
+    mtx_lock(&env->lock);
+    env->quit = true;
+    cnd_broadcast(&env->start);
+    mtx_unlock(&env->lock);
+    for (int i = 0; i < env->threadCount - 1; i++)
+        thrd_join(env->workers[i].thread, NULL);
+
+    for (int i = 0; i < env->count; i++)
+        FreeGameState(&env->games[i]);
+    free(env->games);
+    free(env->seeds);
+    free(env->observations);
+    free(env->rewards);
+    free(env->dones);
+    free(env->workers);
+    cnd_destroy(&env->finished);
+    cnd_destroy(&env->start);
+    mtx_destroy(&env->lock);
+    free(env);
+}
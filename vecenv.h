@@ -0,0 +1,85 @@
+#ifndef VECENV_H
+#define VECENV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "sim.h"     // Game rules, directions and fruit types
+
+// === VECTORIZED ENVIRONMENT ===
+// Many headless games stepped together for reinforcement learning: one call
+// applies one action to every game, advances each by one tick and writes the
+// observations, rewards and end flags into buffers the environment owns. A
+// game that ends is started again at once with its next seed, so the
+// observation returned with done set is already the first one of the new game.
+// The environment is opaque, created and freed by the library, so an FFI
+// caller (ctypes, cffi) only ever holds pointers and plain arrays.
+//
+// Observations are bit-packed board planes, structure of arrays: plane p of
+// game g starts at observations[(p * count + g) * planeWords], and the cell
+// at index y * columns + x is bit (index % 64) of word (index / 64).
+
+// === CONSTANTS ===
+#define VECENV_DEATH_REWARD (-1.0f)   // Added to the score change on the tick the snake dies
+
+// === OBSERVATION PLANES ===
+typedef enum EnvPlane
+{
+    ENV_PLANE_BODY,          // Every snake segment, head included
+    ENV_PLANE_HEAD,          // The head only
+    ENV_PLANE_FENCE,         // Fences
+    ENV_PLANE_FRUIT,         // Fruit of type NORMAL_FRUIT; type t is ENV_PLANE_FRUIT + t
+    ENV_PLANE_COUNT = ENV_PLANE_FRUIT + FRUIT_COUNT
+} EnvPlane;
+
+// === END OF AN EPISODE ===
+// Value written to done[] for each game
+typedef enum EnvDone
+{
+    ENV_RUNNING,             // The game goes on
+    ENV_TERMINATED,          // The snake died or filled the board
+    ENV_TRUNCATED            // Stopped at maxTicks
+} EnvDone;
+
+// === SETTINGS ===
+typedef struct VecEnvConfig
+{
+    int count;               // Number of games
+    int columns;             // Board width in tiles
+    int rows;                // Board height in tiles
+    unsigned int seed;       // Game g starts with seed + g, its next games add count each time
+    int maxTicks;            // Ticks after which a game is truncated (0 = never)
+    int threads;             // Threads stepping the games, the caller's included (1 = no thread)
+} VecEnvConfig;
+
+// === ENVIRONMENT ===
+// Defined in vecenv.c: it holds the threads and their synchronization
+typedef struct VecEnv VecEnv;
+
+// === FUNCTION PROTOTYPES ===
+
+// Create the games, the buffers and the worker threads; returns NULL on failure
+VecEnv* CreateVecEnv(const VecEnvConfig* config);
+
+// Returns the number of games
+int VecEnvCount(const VecEnv* env);
+
+// Returns the number of 64-bit words of the observation buffer (ENV_PLANE_COUNT planes per game)
+size_t VecEnvObservationWords(const VecEnv* env);
+
+// Buffers written by ResetVecEnv() and StepVecEnv(), valid until DestroyVecEnv()
+uint64_t* VecEnvObservations(VecEnv* env);     // VecEnvObservationWords() words
+float* VecEnvRewards(VecEnv* env);             // One per game
+unsigned char* VecEnvDones(VecEnv* env);       // One EnvDone per game
+
+// Start every game again from its next seed and write the first observations
+void ResetVecEnv(VecEnv* env);
+
+// Apply actions[g] (DIRECTION_NONE = keep going) to every game and advance them by one tick
+void StepVecEnv(VecEnv* env, const Direction* actions);
+
+// Stop the workers and free the games and the buffers
+void DestroyVecEnv(VecEnv* env);
+
+#endif // VECENV_H